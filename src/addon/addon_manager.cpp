@@ -18,12 +18,17 @@
 #include "addon/addon_manager.hpp"
 
 #include <physfs.h>
+#include <algorithm>
+#include <atomic>
 #include <fmt/format.h>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
 
 #include "addon/addon.hpp"
 #include "addon/md5.hpp"
 #include "gui/dialog.hpp"
+#include "physfs/ifile_data.hpp"
 #include "physfs/util.hpp"
 #include "supertux/globals.hpp"
 #include "supertux/menu/addon_menu.hpp"
@@ -45,41 +50,66 @@ static const char* ADDON_REPOSITORY_URL = "https://raw.githubusercontent.com/Sup
 
 MD5 md5_from_file(const std::string& filename)
 {
-  // TODO: This does not work as expected for some files -- IFileStream seems to not always behave like an ifstream.
-  //IFileStream ifs(installed_physfs_filename);
-  //std::string md5 = MD5(ifs).hex_digest();
+  IFileData data(filename);
 
   MD5 md5;
+  md5.update(reinterpret_cast<uint8_t*>(const_cast<char*>(data.data())),
+             static_cast<unsigned int>(data.size()));
+  return md5;
+}
 
-  auto file = PHYSFS_openRead(filename.c_str());
-  if (!file)
-  {
-    std::ostringstream out;
-    out << "PHYSFS_openRead() failed: " << physfsutil::get_last_error();
-    throw std::runtime_error(out.str());
-  }
-  else
+/** Computes the MD5 of every archive listed in \a pending, spread over
+    worker threads since each archive has to be read in full. Failures
+    are reported through \a errors, nothing is logged from the workers. */
+void md5_from_archives(const std::vector<std::string>& archives,
+                       const std::vector<size_t>& pending,
+                       std::vector<std::string>& md5s,
+                       std::vector<std::string>& errors)
+{
+  std::atomic<size_t> next(0);
+  auto worker = [&]()
   {
-    while (true)
+    for (size_t n = next++; n < pending.size(); n = next++)
     {
-      unsigned char buffer[1024];
-      PHYSFS_sint64 len = PHYSFS_readBytes(file, buffer, sizeof(buffer));
-      if (len <= 0) break;
-      md5.update(buffer, static_cast<unsigned int>(len));
+      const size_t i = pending[n];
+      try
+      {
+        md5s[i] = md5_from_file(archives[i]).hex_digest();
+      }
+      catch (const std::exception& err)
+      {
+        errors[i] = err.what();
+      }
     }
-    PHYSFS_close(file);
-
-    return md5;
+  };
+
+#ifdef __EMSCRIPTEN__
+  const size_t thread_count = 1;
+#else
+  const size_t thread_count = std::min<size_t>(pending.size(),
+                                               std::max(1u, std::thread::hardware_concurrency()));
+#endif
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads)
+  {
+    thread.join();
   }
 }
 
-MD5 md5_from_archive(const std::string& filename)
+bool stat_archive(const std::string& archive, int64_t& size, int64_t& mtime)
 {
-  if (physfsutil::is_directory(filename)) {
-    return MD5();
-  } else {
-    return md5_from_file(filename);
-  }
+  PHYSFS_Stat stat;
+  if (!PHYSFS_stat(archive.c_str(), &stat))
+    return false;
+
+  size = stat.filesize;
+  mtime = stat.modtime;
+  return true;
 }
 
 static Addon& get_addon(const AddonManager::AddonMap& list, const AddonId& id,
@@ -142,13 +172,15 @@ static PHYSFS_EnumerateCallbackResult remove_from_dictionary_path(void *data, co
 } // namespace
 
 AddonManager::AddonManager(const std::string& addon_directory,
-                           std::vector<Config::Addon>& addon_config) :
+                           std::vector<Config::Addon>& addon_config,
+                           std::vector<Config::AddonHash>& addon_hashes) :
   m_downloader(),
   m_addon_directory(addon_directory),
   m_cache_directory(FileSystem::join(m_addon_directory, "cache")),
   m_screenshots_cache_directory(FileSystem::join(m_cache_directory, "screenshots")),
   m_repository_url(ADDON_REPOSITORY_URL),
   m_addon_config(addon_config),
+  m_addon_hashes(addon_hashes),
   m_installed_addons(),
   m_repository_addons(),
   m_initialized(false),
@@ -320,15 +352,17 @@ AddonManager::request_install_addon(const AddonId& addon_id)
   // Install the add-on.
   TransferStatusPtr status = m_downloader.request_download(addon.get_url(), install_filename);
   status->then(
-    [this, install_filename, addon_id](bool success)
+    [this, install_filename, addon_id, transfer = status.get()](bool success)
     {
       if (success)
       {
         // Complete the add-on installation.
         Addon& repository_addon = get_repository_addon(addon_id);
 
-        MD5 md5 = md5_from_file(install_filename);
-        if (repository_addon.get_md5() != md5.hex_digest())
+        // The Downloader hashes the data as it arrives, only fall back
+        // to reading the file where it can't.
+        const std::string md5 = transfer->md5.empty() ? md5_from_file(install_filename).hex_digest() : transfer->md5;
+        if (repository_addon.get_md5() != md5)
         {
           if (PHYSFS_delete(install_filename.c_str()) == 0)
           {
@@ -345,7 +379,8 @@ AddonManager::request_install_addon(const AddonId& addon_id)
             throw std::runtime_error("PHYSFS_getRealDir failed: " + install_filename);
           }
 
-          add_installed_archive(install_filename, md5.hex_digest());
+          cache_md5(install_filename, md5);
+          add_installed_archive(install_filename, md5);
 
           // Attempt to enable the add-on.
           try
@@ -417,10 +452,13 @@ AddonManager::install_addon(const AddonId& addon_id)
 
   std::string install_filename = FileSystem::join(m_addon_directory, repository_addon.get_filename());
 
-  m_downloader.download(repository_addon.get_url(), install_filename);
+  std::string md5 = m_downloader.download(repository_addon.get_url(), install_filename);
+  if (md5.empty())
+  {
+    md5 = md5_from_file(install_filename).hex_digest();
+  }
 
-  MD5 md5 = md5_from_file(install_filename);
-  if (repository_addon.get_md5() != md5.hex_digest())
+  if (repository_addon.get_md5() != md5)
   {
     if (PHYSFS_delete(install_filename.c_str()) == 0)
     {
@@ -438,7 +476,8 @@ AddonManager::install_addon(const AddonId& addon_id)
     }
     else
     {
-      add_installed_archive(install_filename, md5.hex_digest());
+      cache_md5(install_filename, md5);
+      add_installed_archive(install_filename, md5);
     }
   }
 }
@@ -455,8 +494,9 @@ AddonManager::install_addon_from_local_file(const std::string& filename)
   const std::string& physfs_target_filename = FileSystem::join(m_addon_directory, source_filename);
 
   FileSystem::copy(filename, target_filename);
-  MD5 target_md5 = md5_from_file(physfs_target_filename);
-  add_installed_archive(physfs_target_filename, target_md5.hex_digest(), true);
+  const std::string target_md5 = md5_from_file(physfs_target_filename).hex_digest();
+  cache_md5(physfs_target_filename, target_md5);
+  add_installed_archive(physfs_target_filename, target_md5, true);
 }
 
 void
@@ -576,7 +616,10 @@ AddonManager::enable_addon(const AddonId& addon_id)
     else
     {
       if (addon.get_type() == Addon::LANGUAGEPACK)
+      {
         PHYSFS_enumerate(addon.get_id().c_str(), add_to_dictionary_path, nullptr);
+        invalidate_translations();
+      }
 
       if (m_initialized && addon.overrides_data())
         Resources::reload_all();
@@ -608,7 +651,10 @@ AddonManager::disable_addon(const AddonId& addon_id)
     else
     {
       if (addon.get_type() == Addon::LANGUAGEPACK)
+      {
         PHYSFS_enumerate(addon.get_id().c_str(), remove_from_dictionary_path, nullptr);
+        invalidate_translations();
+      }
 
       if (m_initialized && addon.overrides_data())
         Resources::reload_all();
@@ -855,11 +901,84 @@ AddonManager::add_installed_addons()
 {
   auto archives = scan_for_archives();
 
-  for (const auto& archive : archives)
+  std::vector<std::string> md5s(archives.size());
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < archives.size(); ++i)
+  {
+    if (physfsutil::is_directory(archives[i]))
+    {
+      md5s[i] = MD5().hex_digest();
+    }
+    else
+    {
+      md5s[i] = get_cached_md5(archives[i]);
+      if (md5s[i].empty())
+        pending.push_back(i);
+    }
+  }
+
+  if (!pending.empty())
+  {
+    log_debug << "Hashing " << pending.size() << " of " << archives.size() << " add-on archives" << std::endl;
+
+    std::vector<std::string> errors(archives.size());
+    md5_from_archives(archives, pending, md5s, errors);
+    for (const size_t i : pending)
+    {
+      if (!errors[i].empty())
+        log_warning << "Couldn't hash add-on archive " << archives[i] << ": " << errors[i] << std::endl;
+      else
+        cache_md5(archives[i], md5s[i]);
+    }
+  }
+
+  for (size_t i = 0; i < archives.size(); ++i)
+  {
+    if (!md5s[i].empty())
+      add_installed_archive(archives[i], md5s[i]);
+  }
+
+  // Forget about archives that are gone.
+  const std::unordered_set<std::string> present(archives.begin(), archives.end());
+  m_addon_hashes.erase(std::remove_if(m_addon_hashes.begin(), m_addon_hashes.end(),
+                                      [&present](const Config::AddonHash& hash)
+                                      {
+                                        return present.find(hash.file) == present.end();
+                                      }),
+                       m_addon_hashes.end());
+}
+
+std::string
+AddonManager::get_cached_md5(const std::string& archive) const
+{
+  int64_t size, mtime;
+  if (!stat_archive(archive, size, mtime))
+    return {};
+
+  for (const auto& hash : m_addon_hashes)
+  {
+    if (hash.file == archive)
+      return (hash.size == size && hash.mtime == mtime) ? hash.md5 : std::string();
+  }
+  return {};
+}
+
+void
+AddonManager::cache_md5(const std::string& archive, const std::string& md5)
+{
+  int64_t size, mtime;
+  if (!stat_archive(archive, size, mtime))
+    return;
+
+  for (auto& hash : m_addon_hashes)
   {
-    MD5 md5 = md5_from_archive(archive);
-    add_installed_archive(archive, md5.hex_digest());
+    if (hash.file == archive)
+    {
+      hash = {archive, size, mtime, md5};
+      return;
+    }
   }
+  m_addon_hashes.push_back({archive, size, mtime, md5});
 }
 
 AddonManager::AddonMap
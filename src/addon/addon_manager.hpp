@@ -44,6 +44,7 @@ private:
   const std::string m_screenshots_cache_directory;
   std::string m_repository_url;
   std::vector<Config::Addon>& m_addon_config;
+  std::vector<Config::AddonHash>& m_addon_hashes;
 
   AddonMap m_installed_addons;
   AddonMap m_repository_addons;
@@ -55,7 +56,8 @@ private:
 
 public:
   AddonManager(const std::string& addon_directory,
-               std::vector<Config::Addon>& addon_config);
+               std::vector<Config::Addon>& addon_config,
+               std::vector<Config::AddonHash>& addon_hashes);
   ~AddonManager() override;
 
   void empty_cache_directory();
@@ -101,6 +103,11 @@ private:
 
   std::vector<std::string> scan_for_archives() const;
   void add_installed_addons();
+
+  /** Returns the cached MD5 of \a archive, or an empty string if
+      there is none or the archive changed since it was hashed */
+  std::string get_cached_md5(const std::string& archive) const;
+  void cache_md5(const std::string& archive, const std::string& md5);
   AddonMap parse_addon_infos(const std::string& filename) const;
 
   /** add \a archive, given as physfs path, to the list of installed
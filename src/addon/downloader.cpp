@@ -32,6 +32,7 @@
 #include <emscripten/html5.h>
 #endif
 
+#include "addon/md5.hpp"
 #include "physfs/util.hpp"
 #include "supertux/gameconfig.hpp"
 #include "supertux/globals.hpp"
@@ -52,10 +53,16 @@ size_t my_curl_string_append(void* ptr, size_t size, size_t nmemb, void* userdat
 }
 
 #ifndef EMSCRIPTEN
+struct PhysfsDownload
+{
+  PHYSFS_file* file;
+  MD5 md5;
+};
+
 size_t my_curl_physfs_write(void* ptr, size_t size, size_t nmemb, void* userdata)
 {
-  PHYSFS_file* f = static_cast<PHYSFS_file*>(userdata);
-  PHYSFS_sint64 written = PHYSFS_writeBytes(f, ptr, size * nmemb);
+  PhysfsDownload& download = *static_cast<PhysfsDownload*>(userdata);
+  PHYSFS_sint64 written = PHYSFS_writeBytes(download.file, ptr, size * nmemb);
   log_debug << "read " << size * nmemb << " bytes of data..." << std::endl;
   if (written < 0)
   {
@@ -63,6 +70,7 @@ size_t my_curl_physfs_write(void* ptr, size_t size, size_t nmemb, void* userdata
   }
   else
   {
+    download.md5.update(static_cast<uint8_t*>(ptr), static_cast<unsigned int>(written));
     return static_cast<size_t>(written);
   }
 }
@@ -81,6 +89,7 @@ TransferStatus::TransferStatus(Downloader& downloader, TransferId id_,
   ultotal(0),
   ulnow(0),
   error_msg(),
+  md5(),
   parent_list()
 {}
 
@@ -329,6 +338,9 @@ public:
 
   virtual size_t on_data(const char* ptr, size_t size, size_t nmemb) = 0;
 
+  /** Called once the transfer succeeded, before any callbacks run */
+  virtual void on_complete() {}
+
   int on_progress(double dltotal, double dlnow,
                    double ultotal, double ulnow)
   {
@@ -366,6 +378,7 @@ class FileTransfer final : public Transfer
 private:
 #ifndef EMSCRIPTEN
   std::unique_ptr<PHYSFS_file, int(*)(PHYSFS_File*)> m_fout;
+  MD5 m_md5;
 #endif
 
 public:
@@ -374,7 +387,8 @@ public:
     Transfer(downloader, id, url)
 #ifndef EMSCRIPTEN
     ,
-    m_fout(PHYSFS_openWrite(outfile.c_str()), PHYSFS_close)
+    m_fout(PHYSFS_openWrite(outfile.c_str()), PHYSFS_close),
+    m_md5()
 #endif
   {
 #ifndef EMSCRIPTEN
@@ -397,10 +411,18 @@ public:
   {
 #ifndef EMSCRIPTEN
     PHYSFS_writeBytes(m_fout.get(), ptr, size * nmemb);
+    m_md5.update(reinterpret_cast<uint8_t*>(const_cast<char*>(ptr)), static_cast<unsigned int>(size * nmemb));
 #endif
     return size * nmemb;
   }
 
+  void on_complete() override
+  {
+#ifndef EMSCRIPTEN
+    m_status->md5 = m_md5.hex_digest();
+#endif
+  }
+
 private:
   FileTransfer(const FileTransfer&) = delete;
   FileTransfer& operator=(const FileTransfer&) = delete;
@@ -521,7 +543,7 @@ Downloader::download(const std::string& url)
   return result;
 }
 
-void
+std::string
 Downloader::download(const std::string& url, const std::string& filename)
 {
   if (g_config->disable_network)
@@ -531,13 +553,16 @@ Downloader::download(const std::string& url, const std::string& filename)
   log_info << "download: " << url << " to " << filename << std::endl;
   std::unique_ptr<PHYSFS_file, int(*)(PHYSFS_File*)> fout(PHYSFS_openWrite(filename.c_str()),
                                                           PHYSFS_close);
-  download(url, my_curl_physfs_write, fout.get());
+  PhysfsDownload data{fout.get(), MD5()};
+  download(url, my_curl_physfs_write, &data);
+  return data.md5.hex_digest();
 #else
   log_warning << "Direct download not yet implemented for Emscripten." << std::endl;
   // FUTURE MAINTAINERS: If this needs to be implemented, take a look at
   // emscripten_wget(), emscripten_async_wget(), emscripten_wget_data() and
   // emscripten_async_wget_data():
   // https://emscripten.org/docs/api_reference/emscripten.h.html#c.emscripten_wget
+  return {};
 #endif
 }
 
@@ -635,6 +660,8 @@ Downloader::update()
           assert(it != m_transfers.end());
           TransferStatusPtr status = it->second->get_status();
           status->error_msg = it->second->get_error_buffer();
+          if (resultfromcurl == CURLE_OK)
+            it->second->on_complete();
           m_transfers.erase(it);
 
           if (resultfromcurl == CURLE_OK)
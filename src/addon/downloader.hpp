@@ -49,6 +49,10 @@ public:
 
   std::string error_msg;
 
+  /** Hex MD5 of the downloaded file, hashed while the data arrived.
+      Empty when the data bypasses the Downloader (Emscripten). */
+  std::string md5;
+
 private:
   TransferStatusList* parent_list;
 
@@ -132,8 +136,9 @@ public:
   /** Download \a url and return the result as string */
   std::string download(const std::string& url);
 
-  /** Download \a url and store the result in \a filename */
-  void download(const std::string& url, const std::string& filename);
+  /** Download \a url and store the result in \a filename, returns the
+      hex MD5 of the downloaded data (empty where unsupported) */
+  std::string download(const std::string& url, const std::string& filename);
 
   void download(const std::string& url,
                 size_t (*write_func)(void* ptr, size_t size, size_t nmemb, void* userdata),
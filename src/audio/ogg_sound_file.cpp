@@ -18,17 +18,21 @@
 
 #include <config.h>
 
+#include <algorithm>
 #include <assert.h>
-#include <physfs.h>
+#include <string.h>
 
-OggSoundFile::OggSoundFile(PHYSFS_File* file_, double loop_begin_, double loop_at_) :
-  m_file(file_),
+#include "physfs/ifile_data.hpp"
+
+OggSoundFile::OggSoundFile(std::unique_ptr<IFileData> data, double loop_begin_, double loop_at_) :
+  m_data(std::move(data)),
+  m_pos(0),
   m_vorbis_file(),
   m_loop_begin(),
   m_loop_at()
 {
   ov_callbacks callbacks = { cb_read, cb_seek, cb_close, cb_tell };
-  ov_open_callbacks(m_file, &m_vorbis_file, nullptr, 0, callbacks);
+  ov_open_callbacks(this, &m_vorbis_file, nullptr, 0, callbacks);
 
   vorbis_info* vi = ov_info(&m_vorbis_file, -1);
 
@@ -104,52 +108,56 @@ OggSoundFile::reset()
 size_t
 OggSoundFile::cb_read(void* ptr, size_t size, size_t nmemb, void* source)
 {
-  auto file = reinterpret_cast<PHYSFS_file*> (source);
-
-  PHYSFS_sint64 res
-    = PHYSFS_readBytes(file, ptr, static_cast<PHYSFS_uint32> (size) * static_cast<PHYSFS_uint32> (nmemb));
-  if (res <= 0)
+  auto self = reinterpret_cast<OggSoundFile*> (source);
+  if (size == 0)
     return 0;
 
-  return static_cast<size_t> (res) / size;
+  const size_t available = self->m_data->size() - self->m_pos;
+  const size_t count = std::min(nmemb, available / size);
+  memcpy(ptr, self->m_data->data() + self->m_pos, count * size);
+  self->m_pos += count * size;
+
+  return count;
 }
 
 int
 OggSoundFile::cb_seek(void* source, ogg_int64_t offset, int whence)
 {
-  auto file = reinterpret_cast<PHYSFS_file*> (source);
+  auto self = reinterpret_cast<OggSoundFile*> (source);
 
+  ogg_int64_t pos;
   switch (whence) {
     case SEEK_SET:
-      if (PHYSFS_seek(file, static_cast<PHYSFS_uint64> (offset)) == 0)
-        return -1;
+      pos = offset;
       break;
     case SEEK_CUR:
-      if (PHYSFS_seek(file, PHYSFS_tell(file) + offset) == 0)
-        return -1;
+      pos = static_cast<ogg_int64_t> (self->m_pos) + offset;
       break;
     case SEEK_END:
-      if (PHYSFS_seek(file, PHYSFS_fileLength(file) + offset) == 0)
-        return -1;
+      pos = static_cast<ogg_int64_t> (self->m_data->size()) + offset;
       break;
     default:
       assert(false);
       return -1;
   }
+
+  if (pos < 0 || pos > static_cast<ogg_int64_t> (self->m_data->size()))
+    return -1;
+
+  self->m_pos = static_cast<size_t> (pos);
   return 0;
 }
 
 int
-OggSoundFile::cb_close(void* source)
+OggSoundFile::cb_close(void* /*source*/)
 {
-  auto file = reinterpret_cast<PHYSFS_file*> (source);
-  PHYSFS_close(file);
+  // The data is released together with the OggSoundFile.
   return 0;
 }
 
 long
 OggSoundFile::cb_tell(void* source)
 {
-  auto file = reinterpret_cast<PHYSFS_file*> (source);
-  return static_cast<long> (PHYSFS_tell(file));
+  auto self = reinterpret_cast<OggSoundFile*> (source);
+  return static_cast<long> (self->m_pos);
 }
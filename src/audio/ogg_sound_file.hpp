@@ -16,11 +16,12 @@
 
 #pragma once
 
+#include <memory>
 #include <vorbis/vorbisfile.h>
 
 #include "audio/sound_file.hpp"
 
-struct PHYSFS_File;
+class IFileData;
 
 class OggSoundFile final : public SoundFile
 {
@@ -31,14 +32,16 @@ private:
   static long cb_tell(void* source);
 
 public:
-  OggSoundFile(PHYSFS_File* file, double loop_begin, double loop_at);
+  /** Decodes straight out of 'data', which is usually memory-mapped */
+  OggSoundFile(std::unique_ptr<IFileData> data, double loop_begin, double loop_at);
   ~OggSoundFile() override;
 
   virtual size_t read(void* buffer, size_t buffer_size) override;
   virtual void reset() override;
 
 private:
-  PHYSFS_File* m_file;
+  std::unique_ptr<IFileData> m_data;
+  size_t m_pos;
   OggVorbis_File m_vorbis_file;
   ogg_int64_t m_loop_begin;
   ogg_int64_t m_loop_at;
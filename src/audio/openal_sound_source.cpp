@@ -33,6 +33,14 @@ OpenALSoundSource::OpenALSoundSource() :
   set_reference_distance(128);
 }
 
+OpenALSoundSource::OpenALSoundSource(ALuint source) :
+  m_source(source),
+  m_gain(1.0f),
+  m_volume(1.0f)
+{
+  set_reference_distance(128);
+}
+
 OpenALSoundSource::~OpenALSoundSource()
 {
   stop();
@@ -26,6 +26,8 @@ class OpenALSoundSource : public SoundSource
 
 public:
   OpenALSoundSource();
+  /** Takes ownership of an already generated OpenAL source */
+  explicit OpenALSoundSource(ALuint source);
   ~OpenALSoundSource() override;
 
   virtual void play() override;
@@ -28,6 +28,7 @@
 #include "audio/ogg_sound_file.hpp"
 #include "audio/sound_error.hpp"
 #include "audio/wav_sound_file.hpp"
+#include "physfs/ifile_data.hpp"
 #include "physfs/util.hpp"
 #include "util/file_system.hpp"
 #include "util/reader_document.hpp"
@@ -90,7 +91,8 @@ std::unique_ptr<SoundFile> load_music_file(const std::string& filename_original)
     }
     else
     {
-      return std::make_unique<OggSoundFile>(file, loop_begin, loop_at);
+      return std::make_unique<OggSoundFile>(std::make_unique<IFileData>(file, raw_music_file),
+                                            loop_begin, loop_at);
     }
   }
 }
@@ -103,9 +105,11 @@ std::unique_ptr<SoundFile> load_sound_file(const std::string& filename)
     return load_music_file(filename);
   }
 
-  auto file = PHYSFS_openRead(filename.c_str());
+  std::string path = filename;
+  auto file = PHYSFS_openRead(path.c_str());
   if (!file) {
-    file = PHYSFS_openRead(get_fallback_path(filename).c_str());
+    path = get_fallback_path(filename);
+    file = PHYSFS_openRead(path.c_str());
     if (!file) {
       std::stringstream msg;
       msg << "Couldn't open '" << filename << "': " <<
@@ -121,7 +125,7 @@ std::unique_ptr<SoundFile> load_sound_file(const std::string& filename)
   }
   else
   {
-    return std::make_unique<OggSoundFile>(file, 0, -1);
+    return std::make_unique<OggSoundFile>(std::make_unique<IFileData>(file, path), 0, -1);
   }
 }
 
@@ -17,6 +17,7 @@
 #include "audio/sound_manager.hpp"
 
 #include <SDL.h>
+#include <algorithm>
 #include <assert.h>
 #include <iostream>
 #include <stdexcept>
@@ -27,6 +28,7 @@
 #include "audio/sound_file.hpp"
 #include "audio/stream_sound_source.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 
 SoundManager::SoundManager() :
   m_device(alcOpenDevice(nullptr)),
@@ -35,6 +37,9 @@ SoundManager::SoundManager() :
   m_sound_volume(0),
   m_buffers(),
   m_sources(),
+  m_voices(),
+  m_voice_stats(),
+  m_listener_position(0.0f, 0.0f),
   m_update_list(),
   m_music_source(),
   m_music_enabled(false),
@@ -72,6 +77,7 @@ SoundManager::~SoundManager()
 {
   m_music_source.reset();
   m_sources.clear();
+  m_voices.clear();
 
   for (const auto& buffer : m_buffers) {
     alDeleteBuffers(1, &buffer.second);
@@ -116,36 +122,150 @@ SoundManager::intern_create_sound_source(const std::string& filename)
 {
   assert(m_sound_enabled);
 
+  std::unique_ptr<SoundFile> file;
+  const ALuint buffer = get_buffer(filename, file);
+  if (buffer == AL_NONE)
+    return create_stream_source(filename, std::move(file));
+
   auto source = std::make_unique<OpenALSoundSource>();
   source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+  alSourcei(source->m_source, AL_BUFFER, buffer);
+  return source;
+}
 
-  ALuint buffer;
+std::unique_ptr<OpenALSoundSource>
+SoundManager::create_stream_source(const std::string& filename, std::unique_ptr<SoundFile> file)
+{
+  log_debug << "Playing \"" << filename <<
+    "\" as StreamSoundSource, file size: " << file->m_size << std::endl;
+  auto stream_source = std::make_unique<StreamSoundSource>();
+  stream_source->set_sound_file(std::move(file));
+  stream_source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+  return std::unique_ptr<OpenALSoundSource>(stream_source.release());
+}
 
+ALuint
+SoundManager::get_buffer(const std::string& filename, std::unique_ptr<SoundFile>& stream_file)
+{
   // reuse an existing static sound buffer
   auto it = m_buffers.find(filename);
-  if (it != m_buffers.end()) {
-    buffer = it->second;
-  } else {
-    // Load sound file
-    std::unique_ptr<SoundFile> file(load_sound_file(filename));
-
-    if (file->m_size < 100000) {
-      log_debug << "Adding \"" << filename <<
-        "\" into the buffer, file size: " << file->m_size << std::endl;
-      buffer = load_file_into_buffer(*file);
-      m_buffers.insert(std::make_pair(filename, buffer));
-    } else {
-      log_debug << "Playing \"" << filename <<
-        "\" as StreamSoundSource, file size: " << file->m_size << std::endl;
-      auto stream_source = std::make_unique<StreamSoundSource>();
-      stream_source->set_sound_file(std::move(file));
-      stream_source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
-      return std::unique_ptr<OpenALSoundSource>(stream_source.release());
+  if (it != m_buffers.end())
+    return it->second;
+
+  // Load sound file
+  std::unique_ptr<SoundFile> file(load_sound_file(filename));
+  if (file->m_size >= 100000) {
+    stream_file = std::move(file);
+    return AL_NONE;
+  }
+
+  log_debug << "Adding \"" << filename <<
+    "\" into the buffer, file size: " << file->m_size << std::endl;
+  const ALuint buffer = load_file_into_buffer(*file);
+  m_buffers.insert(std::make_pair(filename, buffer));
+  return buffer;
+}
+
+void
+SoundManager::allocate_voices()
+{
+  std::vector<ALuint> sources(MAX_VOICES);
+
+  alGetError();
+  alGenSources(MAX_VOICES, sources.data());
+  if (alGetError() != AL_NO_ERROR)
+  {
+    // The implementation has less sources to offer, take what we can get.
+    sources.clear();
+    for (int i = 0; i < MAX_VOICES; ++i)
+    {
+      ALuint source;
+      alGenSources(1, &source);
+      if (alGetError() != AL_NO_ERROR)
+        break;
+      sources.push_back(source);
     }
+    log_warning << "Only " << sources.size() << " of " << MAX_VOICES << " audio sources could be allocated" << std::endl;
   }
 
-  alSourcei(source->m_source, AL_BUFFER, buffer);
-  return source;
+  for (ALuint source : sources)
+  {
+    Voice voice;
+    voice.source = std::make_unique<OpenALSoundSource>(source);
+    voice.source->set_volume(static_cast<float>(m_sound_volume) / 100.0f);
+    voice.position = Vector(0.0f, 0.0f);
+    voice.gain = 0.0f;
+    voice.relative = false;
+    voice.active = false;
+    m_voices.push_back(std::move(voice));
+  }
+  m_voice_stats.allocated = static_cast<int>(m_voices.size());
+}
+
+float
+SoundManager::get_voice_priority(const Vector& position, float gain, bool relative) const
+{
+  if (relative)
+    return gain;
+
+  // Approximates the inverse distance model OpenAL uses by default,
+  // with the reference distance set by OpenALSoundSource.
+  const float reference_distance = 128.0f;
+  const float distance = glm::distance(position, m_listener_position);
+  return gain * reference_distance / std::max(reference_distance, distance);
+}
+
+SoundManager::Voice*
+SoundManager::find_voice(const std::string& filename, float priority)
+{
+  Voice* free_voice = nullptr;
+  Voice* weakest_voice = nullptr;
+  float weakest_priority = 0.0f;
+  Voice* weakest_same_voice = nullptr;
+  float weakest_same_priority = 0.0f;
+  int same_count = 0;
+
+  for (auto& voice : m_voices)
+  {
+    if (voice.active && !voice.source->playing() && !voice.source->paused())
+    {
+      voice.active = false;
+      m_voice_stats.active -= 1;
+    }
+
+    if (!voice.active)
+    {
+      if (!free_voice)
+        free_voice = &voice;
+      continue;
+    }
+
+    const float voice_priority = get_voice_priority(voice.position, voice.gain, voice.relative);
+    if (!weakest_voice || voice_priority < weakest_priority)
+    {
+      weakest_voice = &voice;
+      weakest_priority = voice_priority;
+    }
+
+    if (voice.filename == filename)
+    {
+      same_count += 1;
+      if (!weakest_same_voice || voice_priority < weakest_same_priority)
+      {
+        weakest_same_voice = &voice;
+        weakest_same_priority = voice_priority;
+      }
+    }
+  }
+
+  // Too many instances of this sound, replace the quietest one of them.
+  if (same_count >= MAX_VOICES_PER_SOUND)
+    return weakest_same_priority <= priority ? weakest_same_voice : nullptr;
+
+  if (free_voice)
+    return free_voice;
+
+  return (weakest_voice && weakest_priority < priority) ? weakest_voice : nullptr;
 }
 
 std::unique_ptr<SoundSource>
@@ -197,16 +317,59 @@ SoundManager::play(const std::string& filename, const Vector& pos,
   assert(gain >= 0.0f && gain <= 1.0f);
 
   try {
-    std::unique_ptr<OpenALSoundSource> source(intern_create_sound_source(filename));
-    source->set_gain(gain);
+    const bool relative = (pos.x < 0 || pos.y < 0);
 
-    if (pos.x < 0 || pos.y < 0) {
-      source->set_relative(true);
-    } else {
-      source->set_position(pos);
+    std::unique_ptr<SoundFile> file;
+    const ALuint buffer = get_buffer(filename, file);
+    if (buffer == AL_NONE)
+    {
+      // Too large to be kept in memory, stream it from its own source.
+      std::unique_ptr<OpenALSoundSource> source = create_stream_source(filename, std::move(file));
+      source->set_gain(gain);
+      if (relative) {
+        source->set_relative(true);
+      } else {
+        source->set_position(pos);
+      }
+      source->play();
+      m_sources.push_back(std::move(source));
+      return;
     }
-    source->play();
-    m_sources.push_back(std::move(source));
+
+    if (m_voices.empty())
+      allocate_voices();
+
+    Voice* voice = find_voice(filename, get_voice_priority(pos, gain, relative));
+    if (!voice)
+    {
+      m_voice_stats.dropped += 1;
+      return;
+    }
+
+    if (voice->active)
+      m_voice_stats.stolen += 1;
+    else
+      m_voice_stats.active += 1;
+
+    voice->filename = filename;
+    voice->position = pos;
+    voice->gain = gain;
+    voice->relative = relative;
+    voice->active = true;
+
+    // Reset everything a previous sound might have changed.
+    OpenALSoundSource& source = *voice->source;
+    source.stop();
+    alSourcei(source.m_source, AL_BUFFER, buffer);
+    source.set_looping(false);
+    source.set_pitch(1.0f);
+    source.set_velocity(Vector(0.0f, 0.0f));
+    source.set_gain(gain);
+    source.set_relative(relative);
+    source.set_position(relative ? Vector(0.0f, 0.0f) : pos);
+    source.play();
+
+    m_voice_stats.played += 1;
   } catch(std::exception& e) {
     log_warning << "Couldn't play sound " << filename << ": " << e.what() << std::endl;
   }
@@ -363,6 +526,11 @@ SoundManager::pause_sounds()
       source->pause();
     }
   }
+  for (auto& voice : m_voices) {
+    if (voice.active && voice.source->playing()) {
+      voice.source->pause();
+    }
+  }
 }
 
 void
@@ -373,6 +541,11 @@ SoundManager::resume_sounds()
       source->resume();
     }
   }
+  for (auto& voice : m_voices) {
+    if (voice.active && voice.source->paused()) {
+      voice.source->resume();
+    }
+  }
 }
 
 void
@@ -381,6 +554,13 @@ SoundManager::stop_sounds()
   for (auto& source : m_sources) {
     source->stop();
   }
+  for (auto& voice : m_voices) {
+    if (voice.active) {
+      voice.source->stop();
+      voice.active = false;
+    }
+  }
+  m_voice_stats.active = 0;
 }
 
 void
@@ -390,6 +570,9 @@ SoundManager::set_sound_volume(int volume)
   for (auto& source : m_sources) {
     source->set_volume(static_cast<float>(volume) / 100.0f);
   }
+  for (auto& voice : m_voices) {
+    voice.source->set_volume(static_cast<float>(volume) / 100.0f);
+  }
 }
 
 void
@@ -418,6 +601,7 @@ SoundManager::set_listener_position(const Vector& pos)
     return;
   lastticks = current_ticks;
 
+  m_listener_position = pos;
   alListener3f(AL_POSITION, pos.x, pos.y, -300);
 }
 
@@ -437,6 +621,8 @@ SoundManager::set_listener_orientation(const Vector& at, const Vector& up)
 void
 SoundManager::update()
 {
+  PROFILE_ZONE("SoundManager::update");
+
   static Uint32 lasttime = SDL_GetTicks();
   Uint32 now = SDL_GetTicks();
 
@@ -456,6 +642,12 @@ SoundManager::update()
       ++it;
     }
   }
+  for (auto& voice : m_voices) {
+    if (voice.active && !voice.source->playing() && !voice.source->paused()) {
+      voice.active = false;
+      m_voice_stats.active -= 1;
+    }
+  }
   // check streaming sounds
   if (m_music_source) {
     m_music_source->update();
@@ -44,6 +44,22 @@ private:
   static void print_openal_version();
   static void check_al_error(const char* message);
 
+public:
+  /** Number of preallocated sources used for play() */
+  static const int MAX_VOICES = 32;
+
+  /** Maximum number of voices that may play the same sound file at once */
+  static const int MAX_VOICES_PER_SOUND = 4;
+
+  struct VoiceStats final
+  {
+    int active = 0;
+    int allocated = 0;
+    int played = 0;
+    int stolen = 0;
+    int dropped = 0;
+  };
+
 public:
   SoundManager();
   ~SoundManager() override;
@@ -96,16 +112,47 @@ public:
   inline const std::string& get_current_music() const { return m_current_music; }
   void update();
 
+  inline const VoiceStats& get_voice_stats() const { return m_voice_stats; }
+
   /** Tell soundmanager to call update() for stream_sound_source. */
   void register_for_update(StreamSoundSource* sss);
 
   /** Unsubscribe from updates for stream_sound_source. */
   void remove_from_update(StreamSoundSource* sss);
 
+private:
+  /** A preallocated source used to play one-shot sounds */
+  struct Voice final
+  {
+    std::unique_ptr<OpenALSoundSource> source;
+    std::string filename;
+    Vector position;
+    float gain;
+    bool relative;
+    bool active;
+  };
+
 private:
   /** creates a new sound source, might throw exceptions, never returns nullptr */
   std::unique_ptr<OpenALSoundSource> intern_create_sound_source(const std::string& filename);
 
+  /** Returns the buffer of a file small enough to be kept in memory.
+      Returns AL_NONE if it has to be streamed instead, in which case
+      the loaded file is handed over in stream_file. Might throw exceptions. */
+  ALuint get_buffer(const std::string& filename, std::unique_ptr<SoundFile>& stream_file);
+
+  std::unique_ptr<OpenALSoundSource> create_stream_source(const std::string& filename,
+                                                          std::unique_ptr<SoundFile> file);
+
+  void allocate_voices();
+
+  /** How audible a voice is, used to decide which one to steal */
+  float get_voice_priority(const Vector& position, float gain, bool relative) const;
+
+  /** Returns the voice to play a new sound with the given priority on,
+      or nullptr if it should be dropped */
+  Voice* find_voice(const std::string& filename, float priority);
+
   void check_alc_error(const char* message) const;
 
 private:
@@ -117,6 +164,10 @@ private:
   std::map<std::string, ALuint> m_buffers;
   std::vector<std::unique_ptr<OpenALSoundSource> > m_sources;
 
+  std::vector<Voice> m_voices;
+  VoiceStats m_voice_stats;
+  Vector m_listener_position;
+
   std::vector<StreamSoundSource*> m_update_list;
 
   std::unique_ptr<StreamSoundSource> m_music_source;
@@ -154,6 +154,7 @@ public:
   virtual bool is_heavy() const { return false; }
 
   virtual bool always_active() const { return false; }
+  virtual bool is_always_active() const override { return always_active() || MovingObject::is_always_active(); }
 
   bool is_frozen() const;
 
@@ -29,7 +29,9 @@ CollisionObject::CollisionObject(CollisionGroup group, MovingObject& parent) :
   m_unisolid(false),
   m_pressure(),
   m_objects_hit_bottom(),
-  m_ground_movement_manager(nullptr)
+  m_ground_movement_manager(nullptr),
+  m_grid_cells(),
+  m_query_stamp(0)
 {
 }
 
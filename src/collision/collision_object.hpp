@@ -23,6 +23,7 @@
 
 #include "collision/collision_group.hpp"
 #include "collision/collision_hit.hpp"
+#include "math/rect.hpp"
 #include "math/rectf.hpp"
 
 class CollisionGroundMovementManager;
@@ -175,6 +176,14 @@ private:
 
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
+  /** The cells of the CollisionSystem's spatial grid this object is
+      filed under, empty while it isn't in the grid */
+  Rect m_grid_cells;
+
+  /** Used by CollisionSystem queries to report objects that span
+      multiple cells only once */
+  uint32_t m_query_stamp;
+
 private:
   CollisionObject(const CollisionObject&) = delete;
   CollisionObject& operator=(const CollisionObject&) = delete;
@@ -17,6 +17,10 @@
 
 #include "collision/collision_system.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
 #include "collision/collision.hpp"
 #include "collision/collision_movement_manager.hpp"
 #include "editor/editor.hpp"
@@ -27,17 +31,28 @@
 #include "supertux/constants.hpp"
 #include "supertux/sector.hpp"
 #include "supertux/tile.hpp"
+#include "util/profiler.hpp"
 #include "video/color.hpp"
 #include "video/drawing_context.hpp"
 
 namespace
 {
   const float MAX_SPEED = 16.0f;
+
+  const float GRID_CELL_SIZE = 128.0f;
+  const float GRID_MARGIN = 32.0f;
+
+  uint64_t grid_key(int x, int y)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+  }
 } // namespace
 
 CollisionSystem::CollisionSystem(Sector& sector) :
   m_sector(sector),
   m_objects(),
+  m_grid(),
+  m_query_stamp(0),
   m_ground_movement_manager(new CollisionGroundMovementManager)
 {
 }
@@ -47,14 +62,19 @@ CollisionSystem::add(CollisionObject* object)
 {
   object->set_ground_movement_manager(m_ground_movement_manager);
   m_objects.push_back(object);
+  grid_insert(*object);
 }
 
 void
 CollisionSystem::remove(CollisionObject* object)
 {
-  m_objects.erase(
-    std::find(m_objects.begin(), m_objects.end(),
-      object));
+  // Sleeping objects have already been taken out of the broad phase.
+  auto it = std::find(m_objects.begin(), m_objects.end(), object);
+  if (it != m_objects.end())
+  {
+    m_objects.erase(it);
+    grid_erase(*object);
+  }
 
   // FIXME: This is a patch. A better way of fixing this is coming.
   for (auto* collision_object : m_objects) {
@@ -65,6 +85,30 @@ CollisionSystem::remove(CollisionObject* object)
   }
 }
 
+void
+CollisionSystem::remove_sleeping(const std::vector<CollisionObject*>& objects)
+{
+  if (objects.empty())
+    return;
+
+  const std::unordered_set<CollisionObject*> sleeping(objects.begin(), objects.end());
+  m_objects.erase(std::remove_if(m_objects.begin(), m_objects.end(),
+                                 [&sleeping](CollisionObject* object) {
+                                   return sleeping.count(object) != 0;
+                                 }),
+                  m_objects.end());
+
+  for (auto* object : objects) {
+    grid_erase(*object);
+    for (auto* collision_object : m_objects) {
+      collision_object->notify_object_removal(object);
+    }
+    for (auto* tilemap : m_sector.get_solid_tilemaps()) {
+      tilemap->notify_object_removal(object);
+    }
+  }
+}
+
 void
 CollisionSystem::draw(DrawingContext& context)
 {
@@ -582,6 +626,8 @@ CollisionSystem::collision_static_constrains(CollisionObject& object)
 void
 CollisionSystem::update()
 {
+  PROFILE_ZONE("CollisionSystem::update");
+
   if (Editor::is_active()) {
     return;
     // Objects in editor shouldn't collide.
@@ -686,6 +732,8 @@ CollisionSystem::update()
     object->m_bbox = object->m_dest;
     object->m_movement = Vector(0, 0);
   }
+
+  grid_refresh();
 }
 
 bool
@@ -873,7 +921,8 @@ CollisionSystem::get_nearby_objects(const Vector& center, float max_distance) co
 {
   std::vector<CollisionObject*> ret;
 
-  for (const auto& object : m_objects) {
+  const Vector extent(max_distance, max_distance);
+  for (const auto& object : get_objects_in(Rectf(center - extent, center + extent))) {
     float distance = object->get_bbox().distance(center);
     if (distance <= max_distance)
       ret.push_back(object);
@@ -881,3 +930,103 @@ CollisionSystem::get_nearby_objects(const Vector& center, float max_distance) co
 
   return ret;
 }
+
+std::vector<CollisionObject*>
+CollisionSystem::get_objects_in(const Rectf& rect) const
+{
+  std::vector<CollisionObject*> ret;
+
+  // Looking up more cells than there are objects is slower than
+  // simply checking every object.
+  const float max_cells = (rect.get_width() / GRID_CELL_SIZE + 2.0f) * (rect.get_height() / GRID_CELL_SIZE + 2.0f);
+  if (!(max_cells <= static_cast<float>(m_objects.size())))
+  {
+    for (const auto& object : m_objects) {
+      if (rect.overlaps(object->get_bbox()))
+        ret.push_back(object);
+    }
+    return ret;
+  }
+
+  const Rect cells = get_grid_cells(rect);
+  const uint32_t stamp = ++m_query_stamp;
+  for (int x = cells.left; x < cells.right; ++x) {
+    for (int y = cells.top; y < cells.bottom; ++y) {
+      auto it = m_grid.find(grid_key(x, y));
+      if (it == m_grid.end())
+        continue;
+
+      for (auto* object : it->second) {
+        if (object->m_query_stamp == stamp)
+          continue;
+
+        object->m_query_stamp = stamp;
+        if (rect.overlaps(object->get_bbox()))
+          ret.push_back(object);
+      }
+    }
+  }
+
+  return ret;
+}
+
+Rect
+CollisionSystem::get_grid_cells(const Rectf& rect) const
+{
+  return Rect(static_cast<int>(std::floor(rect.get_left() / GRID_CELL_SIZE)),
+              static_cast<int>(std::floor(rect.get_top() / GRID_CELL_SIZE)),
+              static_cast<int>(std::floor(rect.get_right() / GRID_CELL_SIZE)) + 1,
+              static_cast<int>(std::floor(rect.get_bottom() / GRID_CELL_SIZE)) + 1);
+}
+
+void
+CollisionSystem::grid_insert(CollisionObject& object)
+{
+  object.m_grid_cells = get_grid_cells(object.get_bbox().grown(GRID_MARGIN));
+  for (int x = object.m_grid_cells.left; x < object.m_grid_cells.right; ++x) {
+    for (int y = object.m_grid_cells.top; y < object.m_grid_cells.bottom; ++y) {
+      m_grid[grid_key(x, y)].push_back(&object);
+    }
+  }
+}
+
+void
+CollisionSystem::grid_erase(CollisionObject& object)
+{
+  for (int x = object.m_grid_cells.left; x < object.m_grid_cells.right; ++x) {
+    for (int y = object.m_grid_cells.top; y < object.m_grid_cells.bottom; ++y) {
+      auto it = m_grid.find(grid_key(x, y));
+      if (it == m_grid.end())
+        continue;
+
+      auto& cell = it->second;
+      auto entry = std::find(cell.begin(), cell.end(), &object);
+      if (entry != cell.end()) {
+        *entry = cell.back();
+        cell.pop_back();
+      }
+      if (cell.empty())
+        m_grid.erase(it);
+    }
+  }
+  object.m_grid_cells = Rect();
+}
+
+void
+CollisionSystem::grid_refresh()
+{
+  for (auto* object : m_objects) {
+    // Objects that stay well inside their cells keep them, which makes
+    // refreshing static objects free. Re-filing adds the full margin.
+    const Rectf bbox = object->get_bbox().grown(GRID_MARGIN / 2.0f);
+    const Rect& cells = object->m_grid_cells;
+    if (bbox.get_left() >= static_cast<float>(cells.left) * GRID_CELL_SIZE &&
+        bbox.get_top() >= static_cast<float>(cells.top) * GRID_CELL_SIZE &&
+        bbox.get_right() < static_cast<float>(cells.right) * GRID_CELL_SIZE &&
+        bbox.get_bottom() < static_cast<float>(cells.bottom) * GRID_CELL_SIZE)
+      continue;
+
+    grid_erase(*object);
+    grid_insert(*object);
+  }
+}
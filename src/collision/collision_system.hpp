@@ -19,12 +19,14 @@
 
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include <variant>
 #include <stdint.h>
 
 #include "collision/collision.hpp"
 #include "supertux/tile.hpp"
 #include "math/fwd.hpp"
+#include "math/rect.hpp"
 
 class CollisionObject;
 class CollisionGroundMovementManager;
@@ -48,6 +50,10 @@ public:
   void add(CollisionObject* object);
   void remove(CollisionObject* object);
 
+  /** Takes objects out of the broad phase in one pass, without them
+      being destroyed. They can be brought back with add(). */
+  void remove_sleeping(const std::vector<CollisionObject*>& objects);
+
   /** Draw collision shapes for debugging */
   void draw(DrawingContext& context);
 
@@ -80,6 +86,21 @@ public:
 
   std::vector<CollisionObject*> get_nearby_objects(const Vector& center, float max_distance) const;
 
+  /** Returns the objects whose bounding box overlaps \a rect, looked
+      up in the spatial grid. Like everything else in here this only
+      covers objects that aren't sleeping. */
+  std::vector<CollisionObject*> get_objects_in(const Rectf& rect) const;
+
+private:
+  /** Returns the half-open range of grid cells covering \a rect */
+  Rect get_grid_cells(const Rectf& rect) const;
+
+  void grid_insert(CollisionObject& object);
+  void grid_erase(CollisionObject& object);
+
+  /** Re-files the objects whose bounding box left their cells */
+  void grid_refresh();
+
 private:
   /** Does collision detection of an object against all other static
       objects (and the tilemap) in the level. Collision response is
@@ -111,6 +132,12 @@ private:
 
   std::vector<CollisionObject*>  m_objects;
 
+  /** Uniform grid over the objects, keyed by packed cell coordinates.
+      Objects are filed with a margin around their bounding box, so
+      that moving a little between two refreshes doesn't lose them. */
+  std::unordered_map<uint64_t, std::vector<CollisionObject*>> m_grid;
+  mutable uint32_t m_query_stamp;
+
   std::shared_ptr<CollisionGroundMovementManager> m_ground_movement_manager;
 
 private:
@@ -0,0 +1,161 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "control/replay.hpp"
+
+#include <fmt/format.h>
+#include <sstream>
+#include <stdexcept>
+
+#include "control/controller.hpp"
+#include "util/log.hpp"
+
+static_assert(static_cast<int>(Control::CONTROLCOUNT) <= 32, "Control mask does not fit into 32 bits");
+
+const int ReplayWriter::VERSION = 2;
+
+ReplayWriter::ReplayWriter(const std::string& filename, const std::string& level, int seed,
+                           const ReplayStart& start) :
+  m_out(filename),
+  m_mask(0),
+  m_count(0)
+{
+  if (!m_out)
+    throw std::runtime_error(fmt::format("Couldn't open replay file '{}' for writing", filename));
+
+  m_out << "supertux-replay " << VERSION << ' ' << seed << ' ' << level << '\n';
+  if (start.sector)
+    m_out << "sector " << *start.sector << '\n';
+  if (start.spawnpoint)
+    m_out << "spawnpoint " << *start.spawnpoint << '\n';
+  if (start.tux_spawn_pos)
+    m_out << fmt::format("spawn-pos {} {}\n", start.tux_spawn_pos->x, start.tux_spawn_pos->y);
+}
+
+ReplayWriter::~ReplayWriter()
+{
+  flush_run();
+}
+
+void
+ReplayWriter::record(const Controller& controller)
+{
+  uint32_t mask = 0;
+  for (int i = 0; i < static_cast<int>(Control::CONTROLCOUNT); ++i)
+  {
+    if (controller.hold(static_cast<Control>(i)))
+      mask |= (1u << i);
+  }
+
+  if (m_count > 0 && mask != m_mask)
+    flush_run();
+
+  m_mask = mask;
+  ++m_count;
+}
+
+void
+ReplayWriter::flush_run()
+{
+  if (m_count == 0)
+    return;
+
+  m_out << std::hex << m_mask << std::dec << ' ' << m_count << '\n';
+  m_count = 0;
+}
+
+ReplayReader::ReplayReader(const std::string& filename) :
+  m_seed(0),
+  m_level(),
+  m_start(),
+  m_runs(),
+  m_run(0),
+  m_step_in_run(0),
+  m_total_steps(0)
+{
+  std::ifstream in(filename);
+  if (!in)
+    throw std::runtime_error(fmt::format("Couldn't open replay file '{}'", filename));
+
+  std::string magic;
+  int version = 0;
+  in >> magic >> version >> m_seed;
+  std::getline(in >> std::ws, m_level);
+  if (!in || magic != "supertux-replay")
+    throw std::runtime_error(fmt::format("'{}' is not a SuperTux replay file", filename));
+  // Version 1 didn't record the start options.
+  if (version != 1 && version != ReplayWriter::VERSION)
+    throw std::runtime_error(fmt::format("Unsupported replay version {} in '{}'", version, filename));
+
+  std::string line;
+  while (std::getline(in, line))
+  {
+    if (line.empty())
+      continue;
+
+    std::istringstream line_in(line);
+
+    // None of the keywords is a hexadecimal number, so they can't be
+    // confused with the mask of a run.
+    std::string keyword;
+    line_in >> keyword;
+    if (keyword == "sector" || keyword == "spawnpoint")
+    {
+      std::string name;
+      std::getline(line_in >> std::ws, name);
+      (keyword == "sector" ? m_start.sector : m_start.spawnpoint) = name;
+      continue;
+    }
+    else if (keyword == "spawn-pos")
+    {
+      Vector pos(0.0f, 0.0f);
+      line_in >> pos.x >> pos.y;
+      if (!line_in)
+        throw std::runtime_error(fmt::format("Malformed replay line '{}' in '{}'", line, filename));
+      m_start.tux_spawn_pos = pos;
+      continue;
+    }
+
+    line_in.clear();
+    line_in.seekg(0);
+    Run run{0, 0};
+    line_in >> std::hex >> run.mask >> std::dec >> run.count;
+    if (!line_in || run.count <= 0)
+      throw std::runtime_error(fmt::format("Malformed replay line '{}' in '{}'", line, filename));
+
+    m_total_steps += run.count;
+    m_runs.push_back(run);
+  }
+
+  log_info << "Loaded replay '" << filename << "' with " << m_total_steps << " steps" << std::endl;
+}
+
+void
+ReplayReader::apply(Controller& controller)
+{
+  const uint32_t mask = done() ? 0 : m_runs[m_run].mask;
+  for (int i = 0; i < static_cast<int>(Control::CONTROLCOUNT); ++i)
+    controller.set_control(static_cast<Control>(i), (mask & (1u << i)) != 0);
+
+  if (done())
+    return;
+
+  if (++m_step_in_run >= m_runs[m_run].count)
+  {
+    ++m_run;
+    m_step_in_run = 0;
+  }
+}
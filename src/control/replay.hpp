@@ -0,0 +1,108 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <fstream>
+#include <optional>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "math/vector.hpp"
+
+class Controller;
+
+/** Where the player started, if not at the default spawnpoint of the
+    level, from --sector, --spawnpoint and --spawn-pos */
+struct ReplayStart final
+{
+  std::optional<std::string> sector;
+  std::optional<std::string> spawnpoint;
+  std::optional<Vector> tux_spawn_pos;
+};
+
+/**
+ * Records the state of a controller once per logical game step.
+ *
+ * The file starts with a header line "supertux-replay VERSION SEED LEVEL",
+ * followed by optional "sector NAME", "spawnpoint NAME" and
+ * "spawn-pos X Y" lines, and then run-length encoded "MASK COUNT" lines,
+ * where MASK has one bit per Control.
+ */
+class ReplayWriter final
+{
+public:
+  static const int VERSION;
+
+public:
+  ReplayWriter(const std::string& filename, const std::string& level, int seed,
+               const ReplayStart& start);
+  ~ReplayWriter();
+
+  /** Stores the controls held during the current logical step */
+  void record(const Controller& controller);
+
+private:
+  void flush_run();
+
+private:
+  std::ofstream m_out;
+  uint32_t m_mask;
+  int m_count;
+
+private:
+  ReplayWriter(const ReplayWriter&) = delete;
+  ReplayWriter& operator=(const ReplayWriter&) = delete;
+};
+
+/** Feeds controls recorded by ReplayWriter back into a controller */
+class ReplayReader final
+{
+public:
+  /** Throws std::runtime_error if the file is missing or malformed */
+  ReplayReader(const std::string& filename);
+
+  /** Sets the controls of the next recorded step, releases everything
+      once the recording is exhausted */
+  void apply(Controller& controller);
+
+  inline bool done() const { return m_run >= m_runs.size(); }
+  inline int get_seed() const { return m_seed; }
+  inline const std::string& get_level() const { return m_level; }
+  inline const ReplayStart& get_start() const { return m_start; }
+  inline int get_total_steps() const { return m_total_steps; }
+
+private:
+  struct Run
+  {
+    uint32_t mask;
+    int count;
+  };
+
+private:
+  int m_seed;
+  std::string m_level;
+  ReplayStart m_start;
+  std::vector<Run> m_runs;
+  size_t m_run;
+  int m_step_in_run;
+  int m_total_steps;
+
+private:
+  ReplayReader(const ReplayReader&) = delete;
+  ReplayReader& operator=(const ReplayReader&) = delete;
+};
@@ -16,6 +16,7 @@
 
 #include "editor/editor.hpp"
 
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <limits>
@@ -49,6 +50,7 @@
 #include "object/spawnpoint.hpp"
 #include "object/tilemap.hpp"
 #include "physfs/ifile_stream.hpp"
+#include "physfs/ofile_stream.hpp"
 #include "physfs/util.hpp"
 #include "sdk/integration.hpp"
 #include "sprite/sprite_manager.hpp"
@@ -67,6 +69,7 @@
 #include "supertux/tile_manager.hpp"
 #include "supertux/world.hpp"
 #include "util/file_system.hpp"
+#include "util/profiler.hpp"
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "video/compositor.hpp"
@@ -126,6 +129,7 @@ Editor::Editor() :
   m_enabled(false),
   m_bgr_surface(Surface::from_file("images/engine/menu/bg_editor.png")),
   m_time_since_last_save(0.f),
+  m_autosave_future(),
   m_scroll_speed(32.0f),
   m_new_scale(0.f),
   m_mouse_pos(0.f, 0.f),
@@ -146,6 +150,7 @@ Editor::Editor() :
 
 Editor::~Editor()
 {
+  wait_for_autosave();
 }
 
 void
@@ -157,6 +162,8 @@ Editor::queue_layers_refresh()
 void
 Editor::draw(Compositor& compositor)
 {
+  PROFILE_ZONE("Editor::draw");
+
   auto& context = compositor.make_context();
 
   if (m_levelloaded) {
@@ -207,22 +214,17 @@ Editor::draw(Compositor& compositor)
 void
 Editor::update(float dt_sec, const Controller& controller)
 {
+  PROFILE_ZONE("Editor::update");
+
   // Auto-save (interval).
   if (m_level) {
     m_time_since_last_save += dt_sec;
     if (m_time_since_last_save >= static_cast<float>(std::max(
         g_config->editor_autosave_frequency, 1)) * 60.f) {
       m_time_since_last_save = 0.f;
-      std::string backup_filename = get_autosave_from_levelname(m_levelfile);
-      std::string directory = get_level_directory();
-
-      // Set the test level file even though we're not testing, so that
-      // if the user quits the editor without ever testing, it'll delete
-      // the autosave file anyways.
-      m_autosave_levelfile = FileSystem::join(directory, backup_filename);
       try
       {
-        m_level->save(m_autosave_levelfile);
+        autosave();
       }
       catch(const std::exception& e)
       {
@@ -233,6 +235,11 @@ Editor::update(float dt_sec, const Controller& controller)
     m_time_since_last_save = 0.f;
   }
 
+  if (m_autosave_future.valid() &&
+      m_autosave_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+    wait_for_autosave();
+  }
+
   // Pass all requests.
   if (m_reload_request) {
     reload_level();
@@ -314,6 +321,8 @@ Editor::update(float dt_sec, const Controller& controller)
 void
 Editor::remove_autosave_file()
 {
+  wait_for_autosave();
+
   // Clear the auto-save file.
   if (!m_autosave_levelfile.empty())
   {
@@ -369,6 +378,7 @@ Editor::test_level(const std::optional<std::pair<std::string, Vector>>& test_pos
 {
   Tile::draw_editor_images = false;
   Compositor::s_render_lighting = true;
+  const auto start = std::chrono::steady_clock::now();
   std::string backup_filename = get_autosave_from_levelname(m_levelfile);
   std::string directory = get_level_directory();
 
@@ -381,20 +391,89 @@ Editor::test_level(const std::optional<std::pair<std::string, Vector>>& test_pos
     current_world = owned_world.get();
   }
 
-  m_autosave_levelfile = FileSystem::join(directory, backup_filename);
-  m_level->save(m_autosave_levelfile);
+  // The level is played from an in-memory snapshot, the autosave file
+  // only needs to be written by the time the editor is left.
+  const std::string data = autosave();
   m_time_since_last_save = 0.f;
   m_leveltested = true;
 
   if (!m_level->is_worldmap())
   {
+    auto doc = std::make_shared<const ReaderDocument>(ReaderDocument::from_string(data, m_autosave_levelfile));
+    log_info << "Level snapshot taken in "
+             << std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count()
+             << " ms" << std::endl;
+
     // TODO: After LevelSetScreen is removed, this should return a boolean indicating whether load was successful.
     //       If not, call reactivate().
-    GameManager::current()->start_level(*current_world, backup_filename, test_pos);
+    GameManager::current()->start_level(*current_world, backup_filename, test_pos, std::move(doc));
+  }
+  else
+  {
+    // Worldmaps are still loaded from their file.
+    wait_for_autosave();
+    if (!GameManager::current()->start_worldmap(*current_world, m_autosave_levelfile, test_pos))
+      reactivate();
+  }
+}
+
+std::string
+Editor::autosave()
+{
+  wait_for_autosave();
+
+  // Set the autosave file even when not testing, so that it gets deleted
+  // if the user quits the editor without ever testing.
+  m_autosave_levelfile = FileSystem::join(get_level_directory(), get_autosave_from_levelname(m_levelfile));
+
+  std::ostringstream stream;
+  m_level->save(stream);
+  std::string data = stream.str();
+
+  // Check the directory here, like Level::save() does, the background
+  // thread only writes the file. Errors are thrown to the caller.
+  try
+  {
+    Level::create_directory(m_autosave_levelfile);
   }
-  else if (!GameManager::current()->start_worldmap(*current_world, m_autosave_levelfile, test_pos))
+  catch (const std::exception& err)
+  {
+    log_warning << "Failed to autosave the level (" << err.what() << "), retrying..." << std::endl;
+    Level::create_directory(m_autosave_levelfile);
+  }
+
+  auto write = [filename = m_autosave_levelfile, data] {
+    OFileStream file(filename);
+    file << data;
+    file.flush();
+    if (!file)
+      throw std::runtime_error("Couldn't write '" + filename + "'");
+  };
+
+#ifdef __EMSCRIPTEN__
+  m_autosave_future = std::async(std::launch::deferred, write);
+  wait_for_autosave();
+#else
+  m_autosave_future = std::async(std::launch::async, write);
+#endif
+
+  return data;
+}
+
+void
+Editor::wait_for_autosave()
+{
+  if (!m_autosave_future.valid())
+    return;
+
+  try
+  {
+    m_autosave_future.get();
+    log_info << "Level saved as " << m_autosave_levelfile << ". [Autosave]" << std::endl;
+  }
+  catch (const std::exception& err)
   {
-    reactivate();
+    log_warning << "Couldn't autosave: " << err.what() << std::endl;
   }
 }
 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <functional>
+#include <future>
 #include <vector>
 #include <string>
 
@@ -184,6 +185,11 @@ private:
    */
   void save_level(const std::string& filename = "", bool switch_file = false);
   void test_level(const std::optional<std::pair<std::string, Vector>>& test_pos);
+
+  /** Writes the level to the autosave file in the background and
+      returns the written data */
+  std::string autosave();
+  void wait_for_autosave();
   void update_keyboard(const Controller& controller);
 
   void keep_camera_in_bounds();
@@ -233,6 +239,7 @@ private:
   SurfacePtr m_bgr_surface;
 
   float m_time_since_last_save;
+  std::future<void> m_autosave_future;
 
   float m_scroll_speed;
   float m_new_scale;
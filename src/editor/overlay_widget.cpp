@@ -35,6 +35,7 @@
 #include "supertux/game_object_factory.hpp"
 #include "supertux/resources.hpp"
 #include "supertux/sector.hpp"
+#include "util/profiler.hpp"
 #include "video/color.hpp"
 #include "video/drawing_context.hpp"
 #include "video/renderer.hpp"
@@ -46,8 +47,6 @@ namespace {
 
 const int snap_grid_sizes[4] = {4, 8, 16, 32};
 
-const int MAX_FILL_STACK_SIZE = 1000000;
-
 bool is_position_inside_tilemap(const TileMap* tilemap, const Vector& pos)
 {
   return pos.x >= 0 && pos.y >= 0 &&
@@ -83,6 +82,11 @@ EditorOverlayWidget::EditorOverlayWidget(Editor& editor) :
   m_object_tip(new Tip()),
   m_obj_mouse_desync(0, 0),
   m_rectangle_preview(new TileSelection()),
+  m_grid_lines(),
+  m_path_nodes(),
+  m_path_circular(false),
+  m_path_curve_lines(),
+  m_path_handle_lines(),
   m_warning_timer(),
   m_warning_text(),
   m_selection_warning(false),
@@ -203,6 +207,16 @@ EditorOverlayWidget::put_tiles(const Vector& target_tile, TileSelection* tiles)
 {
   m_editor.get_selected_tilemap()->save_state();
 
+  if (m_autotile_mode)
+  {
+    auto autotileset = get_current_autotileset();
+    if (autotileset && !autotileset->is_corner())
+    {
+      put_autotiles(target_tile, tiles, *autotileset);
+      return;
+    }
+  }
+
   Vector add_tile(0.0f, 0.0f);
   for (add_tile.x = static_cast<float>(tiles->m_width) - 1.0f; add_tile.x >= 0.0f; add_tile.x--)
   {
@@ -228,6 +242,43 @@ EditorOverlayWidget::put_tiles(const Vector& target_tile, TileSelection* tiles)
   } // for tile x
 }
 
+void
+EditorOverlayWidget::put_autotiles(const Vector& target_tile, TileSelection* tiles,
+                                   AutotileSet& autotileset)
+{
+  auto tilemap = m_editor.get_selected_tilemap();
+
+  // Place all tiles first, the way input_autotile() and
+  // input_autotile_erase() would, and then autotile the area around
+  // them once, instead of recomputing the neighbourhood of every tile.
+  for (int y = 0; y < tiles->m_height; ++y)
+  {
+    for (int x = 0; x < tiles->m_width; ++x)
+    {
+      const Vector pos = target_tile + Vector(static_cast<float>(x), static_cast<float>(y));
+      if (!is_position_inside_tilemap(tilemap, pos))
+        continue;
+
+      const int tx = static_cast<int>(pos.x), ty = static_cast<int>(pos.y);
+      const uint32_t tile = tiles->pos(x, y);
+      if (tile == 0)
+      {
+        const uint32_t current_tile = tilemap->get_tile_id(tx, ty);
+        if (current_tile == 0 || autotileset.is_member(current_tile))
+          tilemap->change(tx, ty, 0);
+      }
+      else if (autotileset.is_member(tile))
+      {
+        tilemap->change(tx, ty, tile);
+      }
+    }
+  }
+
+  const int left = static_cast<int>(target_tile.x), top = static_cast<int>(target_tile.y);
+  tilemap->autotile_region(Rect(left - 1, top - 1, left + tiles->m_width + 1, top + tiles->m_height + 1),
+                           &autotileset);
+}
+
 namespace {
   // Get integer positions of cartesian grid cells which intersect the line
   // segment from pos1 to pos2 (similarly to a line drawing algorithm)
@@ -378,10 +429,16 @@ EditorOverlayWidget::fill()
 {
   auto tiles = m_editor.get_tiles();
   auto tilemap = m_editor.get_selected_tilemap();
-  if (!tilemap) return;
+  if (!tilemap || !is_position_inside_tilemap(tilemap, m_hovered_tile)) return;
+
+  const int width = tilemap->get_width();
+  const int height = tilemap->get_height();
+  const int start_x = static_cast<int>(m_hovered_tile.x);
+  const int start_y = static_cast<int>(m_hovered_tile.y);
+  const std::vector<uint32_t>& map_tiles = tilemap->get_tiles();
 
   // The tile that is going to be replaced:
-  uint32_t replace_tile = tilemap->get_tile_id(m_hovered_tile);
+  const uint32_t replace_tile = map_tiles[start_y * width + start_x];
 
   if (replace_tile == tiles->pos(0, 0))
   {
@@ -389,91 +446,103 @@ EditorOverlayWidget::fill()
     return;
   }
 
-  std::vector<Vector> pos_stack = { m_hovered_tile };
-
-  // Passing recursively through all tiles to be replaced...
-  while (pos_stack.size())
-  {
-    if (pos_stack.size() > MAX_FILL_STACK_SIZE)
-    {
-      log_warning << "More than 1'000'000 tiles in stack to fill, STOP" << std::endl;
-      return;
-    }
+  // The selection is repeated starting from the hovered tile.
+  auto new_tile = [&](int x, int y) {
+    return tiles->pos(x - start_x, y - start_y);
+  };
 
-    Vector pos = pos_stack.back();
-    Vector tpos = pos - m_hovered_tile;
+  std::vector<bool> filled(map_tiles.size());
+  auto fillable = [&](int x, int y) {
+    const int idx = y * width + x;
+    return !filled[idx] && check_tiles_for_fill(replace_tile, map_tiles[idx], new_tile(x, y));
+  };
 
-    // Tests for being inside tilemap:
-    if (!is_position_inside_tilemap(tilemap, pos))
-    {
-      pos_stack.pop_back();
+  // Scanline fill: each seed is grown into the longest horizontal span
+  // of fillable tiles, and only the start of every fillable run in the
+  // rows above and below it becomes a new seed. The tilemap is left
+  // untouched until the whole area is known.
+  std::vector<int> cells;
+  std::vector<std::pair<int, int>> seeds = { { start_x, start_y } };
+  while (!seeds.empty())
+  {
+    const auto [x, y] = seeds.back();
+    seeds.pop_back();
+    if (filled[y * width + x])
       continue;
-    }
-
-    // Autotile will happen later, so that directional filling works properly
-    input_tile(pos, tiles->pos(static_cast<int>(tpos.x), static_cast<int>(tpos.y)));
 
-    Vector pos_(0.0f, 0.0f);
+    int left = x;
+    while (left > 0 && fillable(left - 1, y))
+      --left;
+    int right = x;
+    while (right < width - 1 && fillable(right + 1, y))
+      ++right;
 
-    // Going left...
-    pos_ = pos + Vector(-1, 0);
-    if (pos_.x >= 0)
+    for (int span_x = left; span_x <= right; ++span_x)
     {
-      if (check_tiles_for_fill(replace_tile,
-          tilemap->get_tile_id(pos_),
-          tiles->pos(static_cast<int>(tpos.x - 1), static_cast<int>(tpos.y))))
-      {
-        pos_stack.push_back( pos_ );
-        continue;
-      }
+      filled[y * width + span_x] = true;
+      cells.push_back(y * width + span_x);
     }
 
-    // Going right...
-    pos_ = pos + Vector(1, 0);
-    if (pos_.x < static_cast<float>(tilemap->get_width()))
+    for (int next_y : { y - 1, y + 1 })
     {
-      if (check_tiles_for_fill(replace_tile,
-          tilemap->get_tile_id(pos_),
-          tiles->pos(static_cast<int>(tpos.x + 1), static_cast<int>(tpos.y))))
-      {
-        pos_stack.push_back( pos_ );
+      if (next_y < 0 || next_y >= height)
         continue;
-      }
-    }
 
-    // Going up...
-    pos_ = pos + Vector(0, -1);
-    if (pos_.y >= 0)
-    {
-      if (check_tiles_for_fill(replace_tile,
-          tilemap->get_tile_id(pos_),
-          tiles->pos(static_cast<int>(tpos.x), static_cast<int>(tpos.y - 1))))
+      bool in_run = false;
+      for (int span_x = left; span_x <= right; ++span_x)
       {
-        pos_stack.push_back( pos_ );
-        continue;
+        const bool can_fill = fillable(span_x, next_y);
+        if (can_fill && !in_run)
+          seeds.emplace_back(span_x, next_y);
+        in_run = can_fill;
       }
     }
+  }
+
+  tilemap->save_state();
+  for (int idx : cells)
+  {
+    tilemap->change(idx, new_tile(idx % width, idx / width));
+  }
+
+  // Autotile happens after filling (because of borders; see snow tileset)
+  if (!m_autotile_mode)
+    return;
+
+  auto autotileset = get_current_autotileset();
+  if (!autotileset)
+    return;
 
-    // Going down...
-    pos_ = pos + Vector(0, 1);
-    if (pos_.y < static_cast<float>(tilemap->get_height()))
+  if (autotileset->is_corner())
+  {
+    for (int idx : cells)
     {
-      if (check_tiles_for_fill(replace_tile,
-          tilemap->get_tile_id(pos_),
-          tiles->pos(static_cast<int>(tpos.x), static_cast<int>(tpos.y + 1))))
-      {
-        pos_stack.push_back( pos_ );
-        continue;
-      }
+      const int x = idx % width, y = idx / width;
+      tilemap->autotile(Vector(static_cast<float>(x), static_cast<float>(y)), new_tile(x, y), autotileset);
     }
+    return;
+  }
 
-    // Autotile happens after directional detection (because of borders; see snow tileset)
-    if (m_autotile_mode)
-      input_autotile(pos, tiles->pos(static_cast<int>(tpos.x), static_cast<int>(tpos.y)));
+  // Every filled autotile and its neighbours are autotiled exactly once.
+  std::vector<bool> affected(map_tiles.size());
+  for (int idx : cells)
+  {
+    const int x = idx % width, y = idx / width;
+    if (!autotileset->is_member(new_tile(x, y)))
+      continue;
+
+    for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, height - 1); ++ny)
+      for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, width - 1); ++nx)
+        affected[ny * width + nx] = true;
+  }
 
-    // When tiles on each side are already filled or occupied by another tiles, it ends.
-    pos_stack.pop_back();
+  std::vector<int> autotile_cells;
+  for (int idx = 0; idx < static_cast<int>(affected.size()); ++idx)
+  {
+    if (affected[idx])
+      autotile_cells.push_back(idx);
   }
+  tilemap->autotile_cells(autotile_cells, autotileset);
 }
 
 void
@@ -1348,7 +1417,7 @@ EditorOverlayWidget::draw_rectangle_preview(DrawingContext& context)
 }
 
 void
-EditorOverlayWidget::draw_tile_grid(DrawingContext& context, int tile_size, bool draw_shadow) const
+EditorOverlayWidget::draw_tile_grid(DrawingContext& context, int tile_size, bool draw_shadow)
 {
   auto current_tm = m_editor.get_selected_tilemap();
   if (current_tm == nullptr) return;
@@ -1359,56 +1428,54 @@ EditorOverlayWidget::draw_tile_grid(DrawingContext& context, int tile_size, bool
                                       (context.get_height() - 32.f) / camera.get_current_scale()));
   Vector start = sp_to_tp( Vector(draw_rect.get_left(), draw_rect.get_top()), tile_size );
   Vector end = sp_to_tp( Vector(draw_rect.get_right(), draw_rect.get_bottom()), tile_size );
-  start.x = std::max(0.0f, start.x);
-  start.y = std::max(0.0f, start.y);
+  start.x = std::max(0.0f, std::floor(start.x));
+  start.y = std::max(0.0f, std::floor(start.y));
   end.x = std::min(static_cast<float>(current_tm->get_width() * (32 / tile_size)), end.x);
   end.y = std::min(static_cast<float>(current_tm->get_height() * (32 / tile_size)), end.y);
 
-  Vector line_start(0.0f, 0.0f);
-  Vector line_end(0.0f, 0.0f);
-  auto draw_line = [&](const Vector& from, const Vector& to, const Color& col)
-  {
-    context.color().draw_line(from, to, col, current_tm->get_layer());
-  };
-  if (draw_shadow)
+  // The lines are drawn with the camera transform, so the shadow has to
+  // be scaled down to stay one pixel wide.
+  const Vector origin = tp_to_sp(Vector(0.0f, 0.0f), tile_size);
+  const Vector viewport_scale = VideoSystem::current()->get_viewport().get_scale();
+  const Vector shadow_offset(1.0f / viewport_scale.x / camera.get_current_scale(),
+                             1.0f / viewport_scale.y / camera.get_current_scale());
+
+  GridLines& grid = m_grid_lines[tile_size];
+  if (!grid.lines ||
+      grid.start != start || grid.end != end ||
+      grid.origin != origin || grid.shadow_offset != shadow_offset)
   {
-    Vector viewport_scale = VideoSystem::current()->get_viewport().get_scale();
-    const Color shadow_colour(0.0f, 0.0f, 0.0f, 0.05f);
-    const Vector shadow_offset(1.0f / viewport_scale.x,
-      1.0f / viewport_scale.y);
+    grid.start = start;
+    grid.end = end;
+    grid.origin = origin;
+    grid.shadow_offset = shadow_offset;
+
+    auto lines = std::make_shared<std::vector<Vector>>();
     for (int i = static_cast<int>(start.x); i <= static_cast<int>(end.x); i++)
     {
-      line_start = tile_screen_pos(Vector(static_cast<float>(i), 0.0f),
-        tile_size) + shadow_offset;
-      line_end = tile_screen_pos(Vector(static_cast<float>(i), end.y),
-        tile_size) + shadow_offset;
-      draw_line(line_start, line_end, shadow_colour);
+      lines->push_back(tp_to_sp(Vector(static_cast<float>(i), 0.0f), tile_size));
+      lines->push_back(tp_to_sp(Vector(static_cast<float>(i), end.y), tile_size));
     }
 
     for (int i = static_cast<int>(start.y); i <= static_cast<int>(end.y); i++)
     {
-      line_start = tile_screen_pos(Vector(0.0f, static_cast<float>(i)),
-        tile_size) + shadow_offset;
-      line_end = tile_screen_pos(Vector(end.x, static_cast<float>(i)),
-        tile_size) + shadow_offset;
-      draw_line(line_start, line_end, shadow_colour);
+      lines->push_back(tp_to_sp(Vector(0.0f, static_cast<float>(i)), tile_size));
+      lines->push_back(tp_to_sp(Vector(end.x, static_cast<float>(i)), tile_size));
     }
-  }
 
-  const Color line_color(1.f, 1.f, 1.f, 0.2f);
-  for (int i = static_cast<int>(start.x); i <= static_cast<int>(end.x); i++)
-  {
-    line_start = tile_screen_pos(Vector(static_cast<float>(i), 0.0f), tile_size);
-    line_end = tile_screen_pos(Vector(static_cast<float>(i), end.y), tile_size);
-    draw_line(line_start, line_end, line_color);
-  }
+    auto shadow_lines = std::make_shared<std::vector<Vector>>();
+    shadow_lines->reserve(lines->size());
+    for (const auto& point : *lines)
+      shadow_lines->push_back(point + shadow_offset);
 
-  for (int i = static_cast<int>(start.y); i <= static_cast<int>(end.y); i++)
-  {
-    line_start = tile_screen_pos(Vector(0.0f, static_cast<float>(i)), tile_size);
-    line_end = tile_screen_pos(Vector(end.x, static_cast<float>(i)), tile_size);
-    draw_line(line_start, line_end, line_color);
+    // Replaced rather than modified, a frame in flight may still use them.
+    grid.lines = std::move(lines);
+    grid.shadow_lines = std::move(shadow_lines);
   }
+
+  if (draw_shadow)
+    context.color().draw_lines(grid.shadow_lines, Color(0.0f, 0.0f, 0.0f, 0.05f), current_tm->get_layer());
+  context.color().draw_lines(grid.lines, Color(1.f, 1.f, 1.f, 0.2f), current_tm->get_layer());
 }
 
 void
@@ -1419,13 +1486,14 @@ EditorOverlayWidget::draw_tilemap_border(DrawingContext& context)
   auto current_tm = m_editor.get_selected_tilemap();
   if (!current_tm) return;
 
-  Vector start = tile_screen_pos( Vector(0, 0) );
-  Vector end = tile_screen_pos( Vector(static_cast<float>(current_tm->get_width()),
-                                       static_cast<float>(current_tm->get_height())) );
-  context.color().draw_line(start, Vector(start.x, end.y), Color(1, 0, 1), current_tm->get_layer());
-  context.color().draw_line(start, Vector(end.x, start.y), Color(1, 0, 1), current_tm->get_layer());
-  context.color().draw_line(Vector(start.x, end.y), end, Color(1, 0, 1), current_tm->get_layer());
-  context.color().draw_line(Vector(end.x, start.y), end, Color(1, 0, 1), current_tm->get_layer());
+  Vector start = tp_to_sp( Vector(0, 0) );
+  Vector end = tp_to_sp( Vector(static_cast<float>(current_tm->get_width()),
+                                static_cast<float>(current_tm->get_height())) );
+  context.color().draw_lines({ start, Vector(start.x, end.y),
+                               start, Vector(end.x, start.y),
+                               Vector(start.x, end.y), end,
+                               Vector(end.x, start.y), end },
+                             Color(1, 0, 1), current_tm->get_layer());
 }
 
 void
@@ -1436,67 +1504,67 @@ EditorOverlayWidget::draw_path(DrawingContext& context)
   if (!m_selected_object->is_valid()) return;
   if (!m_edited_path->is_valid()) return;
 
-  for (auto i = m_edited_path->get_path().m_nodes.begin(); i != m_edited_path->get_path().m_nodes.end(); ++i)
+  const Path& path = m_edited_path->get_path();
+  const bool circular = path.m_mode == WalkMode::CIRCULAR;
+
+  // Only rebuild the lines when a node or handle has moved.
+  bool changed = circular != m_path_circular || m_path_nodes.size() != path.m_nodes.size() * 3;
+  for (size_t i = 0; !changed && i < path.m_nodes.size(); ++i)
+  {
+    const Path::Node& node = path.m_nodes[i];
+    changed = m_path_nodes[i * 3] != node.position ||
+              m_path_nodes[i * 3 + 1] != node.bezier_before ||
+              m_path_nodes[i * 3 + 2] != node.bezier_after;
+  }
+
+  if (changed || !m_path_curve_lines)
   {
-    auto j = i+1;
-    Path::Node* node1 = &(*i);
-    Path::Node* node2;
-    if (j == m_edited_path->get_path().m_nodes.end())
+    m_path_circular = circular;
+    m_path_nodes.clear();
+
+    auto curve_lines = std::make_shared<std::vector<Vector>>();
+    auto handle_lines = std::make_shared<std::vector<Vector>>();
+
+    for (auto i = path.m_nodes.begin(); i != path.m_nodes.end(); ++i)
     {
-      if (m_edited_path->get_path().m_mode == WalkMode::CIRCULAR)
-      {
-        //loop to the first node
-        node2 = &(*m_edited_path->get_path().m_nodes.begin());
-      }
-      else
+      m_path_nodes.push_back(i->position);
+      m_path_nodes.push_back(i->bezier_before);
+      m_path_nodes.push_back(i->bezier_after);
+
+      handle_lines->push_back(i->position);
+      handle_lines->push_back(i->bezier_before);
+      handle_lines->push_back(i->position);
+      handle_lines->push_back(i->bezier_after);
+
+      auto j = i + 1;
+      if (j == path.m_nodes.end())
       {
-        // Just draw the bezier lines
-        context.color().draw_line(node1->position,
-                                  node1->bezier_before,
-                                  Color(0, 0, 1), LAYER_GUI - 21);
-        context.color().draw_line(node1->position,
-                                  node1->bezier_after,
-                                  Color(0, 0, 1), LAYER_GUI - 21);
-        continue;
+        // Loop to the first node, or just draw the bezier handles.
+        if (!circular)
+          continue;
+        j = path.m_nodes.begin();
       }
+      Bezier::append_curve_lines(*curve_lines,
+                                 i->position,
+                                 i->bezier_after,
+                                 j->bezier_before,
+                                 j->position,
+                                 100);
     }
-    else
-    {
-      node2 = &(*j);
-    }
-    Bezier::draw_curve(context,
-                       node1->position,
-                       node1->bezier_after,
-                       node2->bezier_before,
-                       node2->position,
-                       100,
-                       Color::RED,
-                       LAYER_GUI - 21);
-    context.color().draw_line(node1->position,
-                              node1->bezier_before,
-                              Color(0, 0, 1), LAYER_GUI - 21);
-    context.color().draw_line(node1->position,
-                              node1->bezier_after,
-                              Color(0, 0, 1), LAYER_GUI - 21);
-    //context.color().draw_line(node1->position,
-    //                          node2->position,
-    //                          Color(1, 0, 0), LAYER_GUI - 21);
+
+    // Replaced rather than modified, a frame in flight may still use them.
+    m_path_curve_lines = std::move(curve_lines);
+    m_path_handle_lines = std::move(handle_lines);
   }
+
+  context.color().draw_lines(m_path_curve_lines, Color::RED, LAYER_GUI - 21);
+  context.color().draw_lines(m_path_handle_lines, Color(0, 0, 1), LAYER_GUI - 21);
 }
 
 void
 EditorOverlayWidget::draw(DrawingContext& context)
 {
-  if (g_config->editor_render_grid)
-  {
-    draw_tile_grid(context, 32, true);
-    draw_tilemap_border(context);
-    auto snap_grid_size = snap_grid_sizes[g_config->editor_selected_snap_grid_size];
-    if (snap_grid_size != 32)
-    {
-      draw_tile_grid(context, snap_grid_size, false);
-    }
-  }
+  PROFILE_ZONE("EditorOverlayWidget::draw");
 
   m_object_tip->draw(context, m_mouse_pos);
 
@@ -1513,6 +1581,17 @@ EditorOverlayWidget::draw(DrawingContext& context)
   context.set_translation(m_editor.get_sector()->get_camera().get_translation());
   context.transform().scale = scale;
 
+  if (g_config->editor_render_grid)
+  {
+    draw_tile_grid(context, 32, true);
+    draw_tilemap_border(context);
+    auto snap_grid_size = snap_grid_sizes[g_config->editor_selected_snap_grid_size];
+    if (snap_grid_size != 32)
+    {
+      draw_tile_grid(context, snap_grid_size, false);
+    }
+  }
+
   draw_tile_tip(context);
   draw_rectangle_preview(context);
   draw_path(context);
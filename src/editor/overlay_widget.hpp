@@ -18,6 +18,9 @@
 
 #include <SDL.h>
 #include <chrono>
+#include <map>
+#include <memory>
+#include <vector>
 
 #include "control/input_manager.hpp"
 #include "editor/tile_selection.hpp"
@@ -81,6 +84,7 @@ private:
   void input_autotile(const Vector& pos, uint32_t tile);
   void input_autotile_erase(const Vector& pos);
   void put_tiles(const Vector& target_tile, TileSelection* tiles);
+  void put_autotiles(const Vector& target_tile, TileSelection* tiles, AutotileSet& autotileset);
   void put_next_tiles();
   void draw_rectangle();
   void preview_rectangle();
@@ -104,7 +108,7 @@ private:
   std::string get_autotileset_key_range() const;
 
   void draw_tile_tip(DrawingContext&);
-  void draw_tile_grid(DrawingContext&, int tile_size, bool draw_shadow) const;
+  void draw_tile_grid(DrawingContext&, int tile_size, bool draw_shadow);
   void draw_tilemap_border(DrawingContext&);
   void draw_path(DrawingContext&);
   void draw_rectangle_preview(DrawingContext& context);
@@ -132,6 +136,19 @@ private:
   }
 
 private:
+  /** Line geometry of a tile grid, in sector coordinates. It's rebuilt
+      when the visible range of tiles, the tilemap offset, the zoom or
+      the viewport scale change, not when scrolling within a tile. */
+  struct GridLines final
+  {
+    Vector start;
+    Vector end;
+    Vector origin;
+    Vector shadow_offset;
+    std::shared_ptr<const std::vector<Vector>> shadow_lines;
+    std::shared_ptr<const std::vector<Vector>> lines;
+  };
+
   Editor& m_editor;
   Vector m_hovered_tile;
   Vector m_hovered_tile_prev;
@@ -161,6 +178,16 @@ private:
 
   std::unique_ptr<TileSelection> m_rectangle_preview;
 
+  /** Cached tile grids, by tile size */
+  std::map<int, GridLines> m_grid_lines;
+
+  /** Cached curve and handle lines of the edited path, valid as long
+      as m_path_nodes matches its node positions and handles */
+  std::vector<Vector> m_path_nodes;
+  bool m_path_circular;
+  std::shared_ptr<const std::vector<Vector>> m_path_curve_lines;
+  std::shared_ptr<const std::vector<Vector>> m_path_handle_lines;
+
   // Warnings
   Timer m_warning_timer;
   std::string m_warning_text;
@@ -17,6 +17,8 @@
 
 #include "editor/tilebox.hpp"
 
+#include <algorithm>
+
 #include "editor/editor.hpp"
 #include "editor/object_info.hpp"
 #include "editor/tile_selection.hpp"
@@ -99,13 +101,12 @@ EditorTilebox::draw(DrawingContext& context)
 void
 EditorTilebox::draw_tilegroup(DrawingContext& context)
 {
-  int pos = -1;
-  for (auto& tile_ID : m_active_tilegroup->tiles)
+  // Only the rows currently scrolled into view are drawn.
+  const auto& tiles = m_active_tilegroup->tiles;
+  const int end = std::min(static_cast<int>(tiles.size()), get_last_visible_row() * 4 + 4);
+  for (int pos = get_first_visible_row() * 4; pos < end; ++pos)
   {
-    pos++;
-    if (pos / 4 < static_cast<int>(m_scroll_progress / 32.f))
-      continue;
-
+    const int tile_ID = tiles[pos];
     auto position = get_tile_coords(pos, false);
     m_editor.get_tileset()->get(tile_ID).draw(context.color(), position, LAYER_GUI - 9);
 
@@ -121,17 +122,26 @@ EditorTilebox::draw_tilegroup(DrawingContext& context)
 void
 EditorTilebox::draw_objectgroup(DrawingContext& context)
 {
-  int pos = -1;
-  for (auto& icon : m_active_objectgroup->get_icons())
+  auto& icons = m_active_objectgroup->get_icons();
+  const int end = std::min(static_cast<int>(icons.size()), get_last_visible_row() * 4 + 4);
+  for (int pos = get_first_visible_row() * 4; pos < end; ++pos)
   {
-    pos++;
-    if (pos / 4 < static_cast<int>(m_scroll_progress / 32.f))
-      continue;
-
-    icon.draw(context, get_tile_coords(pos, false));
+    icons[pos].draw(context, get_tile_coords(pos, false));
   }
 }
 
+int
+EditorTilebox::get_first_visible_row() const
+{
+  return static_cast<int>(m_scroll_progress / 32.f);
+}
+
+int
+EditorTilebox::get_last_visible_row() const
+{
+  return static_cast<int>((m_scroll_progress + m_rect.get_height()) / 32.f);
+}
+
 Rectf
 EditorTilebox::normalize_selection(bool rounded) const
 {
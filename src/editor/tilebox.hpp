@@ -106,6 +106,10 @@ private:
   void draw_tilegroup(DrawingContext& context);
   void draw_objectgroup(DrawingContext& context);
 
+  /** Range of rows (of 4 tiles each) currently scrolled into view */
+  int get_first_visible_row() const;
+  int get_last_visible_row() const;
+
 private:
   Editor& m_editor;
 
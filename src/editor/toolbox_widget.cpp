@@ -73,10 +73,13 @@ EditorToolboxWidget::draw(DrawingContext& context)
                                      0.0f, LAYER_GUI - 5);
   }
 
-  context.color().draw_text(Resources::normal_font, _("Tiles"),
+  static const TranslatedString s_tiles(N_("Tiles"));
+  static const TranslatedString s_objects(N_("Objects"));
+
+  context.color().draw_text(Resources::normal_font, s_tiles,
                             Vector(context.get_width(), 5),
                             ALIGN_RIGHT, LAYER_GUI, ColorScheme::Menu::default_color);
-  context.color().draw_text(Resources::normal_font, _("Objects"),
+  context.color().draw_text(Resources::normal_font, s_objects,
                             Vector(context.get_width(), 37),
                             ALIGN_RIGHT, LAYER_GUI, ColorScheme::Menu::default_color);
 
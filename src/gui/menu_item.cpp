@@ -41,12 +41,13 @@ MenuItem::~MenuItem()
 void
 MenuItem::set_help(const std::string& help_text)
 {
-  std::string overflow;
-  m_help = m_font->wrap_to_width(help_text, HELP_TEXT_WIDTH, &overflow);
-  while (!overflow.empty())
+  m_help.clear();
+  const auto& lines = m_font->wrap_to_lines(help_text, HELP_TEXT_WIDTH);
+  for (size_t i = 0; i < lines.size(); ++i)
   {
-    m_help += "\n";
-    m_help += m_font->wrap_to_width(overflow, HELP_TEXT_WIDTH, &overflow);
+    if (i > 0)
+      m_help += "\n";
+    m_help += lines[i];
   }
 }
 
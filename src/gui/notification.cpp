@@ -145,16 +145,19 @@ Notification::draw(DrawingContext& context)
   m_mouse_over_sym1 = sym1_rect.contains(m_mouse_pos);
   m_mouse_over_sym2 = sym2_rect.contains(m_mouse_pos);
 
+  static const TranslatedString s_do_not_show(N_("Do not show again"));
+  static const TranslatedString s_close(N_("Close"));
+
   if (m_mouse_over_sym1)
   {
-    context.color().draw_text(Resources::normal_font, _("Do not show again"),
+    context.color().draw_text(Resources::normal_font, s_do_not_show,
                                 Vector(m_mouse_pos.x,
                                        m_mouse_pos.y + 20.0f),
                                 ALIGN_RIGHT, LAYER_GUI + 1, Color::CYAN);
   }
   else if (m_mouse_over_sym2)
   {
-    context.color().draw_text(Resources::normal_font, _("Close"),
+    context.color().draw_text(Resources::normal_font, s_close,
                                 Vector(m_mouse_pos.x,
                                        m_mouse_pos.y + 20.0f),
                                 ALIGN_RIGHT, LAYER_GUI + 1, Color::CYAN);
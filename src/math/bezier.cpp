@@ -103,22 +103,31 @@ void
 Bezier::draw_curve(DrawingContext& context, const Vector& p1, const Vector& p2,
                    const Vector& p3, const Vector& p4, int steps, Color color,
                    int layer)
+{
+  std::vector<Vector> lines;
+  append_curve_lines(lines, p1, p2, p3, p4, steps);
+  context.color().draw_lines(std::move(lines), color, layer);
+}
+
+void
+Bezier::append_curve_lines(std::vector<Vector>& lines, const Vector& p1, const Vector& p2,
+                           const Vector& p3, const Vector& p4, int steps)
 {
   // Save ourselves some processing time in common special cases.
   if (p1 == p2 && p3 == p4)
   {
-    context.color().draw_line(p1, p4, color, layer);
+    lines.push_back(p1);
+    lines.push_back(p4);
     return;
   }
 
+  lines.reserve(lines.size() + 2 * steps);
+  Vector prev = p1;
   for (int i = 0; i < steps; i += 1)
   {
-    float f1 = static_cast<float>(i) / static_cast<float>(steps),
-          f2 = static_cast<float>(i + 1) / static_cast<float>(steps);
-
-    context.color().draw_line(get_point(p1, p2, p3, p4, f1),
-                              get_point(p1, p2, p3, p4, f2),
-                              color,
-                              layer);
+    const Vector next = get_point(p1, p2, p3, p4, static_cast<float>(i + 1) / static_cast<float>(steps));
+    lines.push_back(prev);
+    lines.push_back(next);
+    prev = next;
   }
 }
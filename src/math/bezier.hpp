@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <math/vector.hpp>
 
 class Color;
@@ -36,6 +38,8 @@ public:
   static Vector get_point_by_length(const Vector& p1, const Vector& p2, const Vector& p3, const Vector& p4, float t);
   // FIXME: Move this to the Canvas object?
   static void draw_curve(DrawingContext& context, const Vector& p1, const Vector& p2, const Vector& p3, const Vector& p4, int steps, Color color, int layer);
+  // Appends the start and end point of each of the 'steps' lines approximating the curve, for Canvas::draw_lines()
+  static void append_curve_lines(std::vector<Vector>& lines, const Vector& p1, const Vector& p2, const Vector& p3, const Vector& p4, int steps);
 
 private:
   Bezier(const Bezier&) = delete;
@@ -51,6 +51,10 @@ public:
   virtual bool has_variable_size() const override { return true; }
   virtual GameObjectClasses get_class_types() const override { return MovingObject::get_class_types().add(typeid(AmbientSound)); }
 
+  /** The gain depends on the distance to the nearest player, which may
+      reach further than the active region */
+  virtual bool is_always_active() const override { return true; }
+
   virtual void draw(DrawingContext& context) override;
 
   virtual ObjectSettings get_settings() override;
@@ -91,6 +91,7 @@ public:
   virtual bool is_saveable() const override { return false; }
   virtual bool is_singleton() const override { return false; }
   virtual bool has_object_manager_priority() const override { return true; }
+  virtual bool is_always_active() const override { return true; }
   virtual std::string get_exposed_class_name() const override { return "Player"; }
   virtual void remove_me() override;
   virtual GameObjectClasses get_class_types() const override { return MovingObject::get_class_types().add(typeid(Player)); }
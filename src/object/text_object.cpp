@@ -80,15 +80,13 @@ TextObject::wrap_text()
 {
   m_wrapped_text.clear();
 
-  std::string rest = m_text;
-  do {
-    std::string overflow;
-    m_wrapped_text += m_font->wrap_to_width(rest, m_wrap_width, &overflow);
-    if (!overflow.empty()) {
+  const auto& lines = m_font->wrap_to_lines(m_text, m_wrap_width);
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    if (i > 0)
       m_wrapped_text += "\n";
-    }
-    rest = overflow;
-  } while (!rest.empty());
+    m_wrapped_text += lines[i];
+  }
 }
 
 void
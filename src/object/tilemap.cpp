@@ -41,11 +41,21 @@
 #include "video/layer.hpp"
 #include "video/surface.hpp"
 
+namespace {
+
+/** Source of the tilemap revisions, which are unique across tilemaps */
+uint32_t s_revision = 0;
+
+} // namespace
+
 TileMap::TileMap(const TileSet *new_tileset) :
   PathObject(),
   m_editor_active(true),
   m_tileset(new_tileset),
   m_tiles(),
+  m_tile_index(),
+  m_tile_index_pos(),
+  m_revision(++s_revision),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -80,6 +90,9 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
   m_editor_active(true),
   m_tileset(tileset_),
   m_tiles(),
+  m_tile_index(),
+  m_tile_index_pos(),
+  m_revision(++s_revision),
   m_real_solid(false),
   m_effective_solid(false),
   m_speed_x(1),
@@ -163,6 +176,10 @@ TileMap::TileMap(const TileSet *tileset_, const ReaderMapping& reader) :
 void
 TileMap::parse_tiles(const ReaderMapping& reader)
 {
+  m_tile_index.clear();
+  m_tile_index_pos.clear();
+  m_revision = ++s_revision;
+
   reader.get("width", m_width);
   reader.get("height", m_height);
   if (m_width < 0 || m_height < 0)
@@ -498,6 +515,9 @@ TileMap::editor_update()
 void
 TileMap::on_flip(float height)
 {
+  m_tile_index.clear();
+  m_tile_index_pos.clear();
+  m_revision = ++s_revision;
   for (int x = 0; x < get_width(); ++x) {
     for (int y = 0; y < get_height()/2; ++y) {
       // swap tiles
@@ -580,8 +600,9 @@ TileMap::draw(DrawingContext& context)
 
       const SurfacePtr& surface = Editor::is_active() ? tile.get_current_editor_surface() : tile.get_current_surface();
       if (surface) {
-        std::get<0>(batches[surface]).emplace_back(surface->get_region());
-        std::get<1>(batches[surface]).emplace_back(pos,
+        auto& batch = batches[surface];
+        std::get<0>(batch).emplace_back(surface->get_region());
+        std::get<1>(batch).emplace_back(pos,
                                                    Sizef(static_cast<float>(surface->get_width()),
                                                          static_cast<float>(surface->get_height())));
       }
@@ -616,6 +637,9 @@ TileMap::set(int newwidth, int newheight, const std::vector<unsigned int>&newt,
 
   m_tiles.resize(newt.size());
   m_tiles = newt;
+  m_tile_index.clear();
+  m_tile_index_pos.clear();
+  m_revision = ++s_revision;
 
   if (new_z_pos > (LAYER_GUI - 100))
     m_z_pos = LAYER_GUI - 100;
@@ -633,6 +657,10 @@ void
 TileMap::resize(int new_width, int new_height, int fill_id,
                 int xoffset, int yoffset)
 {
+  m_tile_index.clear();
+  m_tile_index_pos.clear();
+  m_revision = ++s_revision;
+
   bool offset_finished_x = false;
   bool offset_finished_y = false;
   if (xoffset < 0 && new_width - m_width < 0)
@@ -777,13 +805,13 @@ TileMap::change(int x, int y, uint32_t newtile)
   if(x < 0 || x >= m_width || y < 0 || y >= m_height)
     return;
 
-  m_tiles[y*m_width + x] = newtile;
+  set_tile(y*m_width + x, newtile);
 }
 
 void
 TileMap::change(int idx, uint32_t newtile)
 {
-  m_tiles[idx] = newtile;
+  set_tile(idx, newtile);
 }
 
 void
@@ -802,14 +830,78 @@ TileMap::change_at(float x, float y, uint32_t newtile)
 void
 TileMap::change_all(uint32_t oldtile, uint32_t newtile)
 {
-  for (int x = 0; x < get_width(); x++) {
-    for (int y = 0; y < get_height(); y++) {
-      if (get_tile_id(x,y) != oldtile)
-        continue;
+  if (oldtile == newtile)
+    return;
+
+  // Both lists are looked up first, so that swapping the tiles back
+  // later on doesn't need another scan either.
+  std::vector<int>& new_cells = get_tile_cells(newtile);
+  std::vector<int>& old_cells = get_tile_cells(oldtile);
+
+  for (const int idx : old_cells)
+    m_tiles[idx] = newtile;
+  if (!old_cells.empty())
+    m_revision = ++s_revision;
+
+  for (const int idx : old_cells)
+  {
+    m_tile_index_pos[idx] = static_cast<int>(new_cells.size());
+    new_cells.push_back(idx);
+  }
+  old_cells.clear();
+}
+
+void
+TileMap::set_tile(int idx, uint32_t id)
+{
+  const uint32_t old_id = m_tiles[idx];
+  if (old_id == id)
+    return;
+
+  m_tiles[idx] = id;
+  m_revision = ++s_revision;
+
+  if (m_tile_index.empty())
+    return;
+
+  auto it = m_tile_index.find(old_id);
+  if (it != m_tile_index.end())
+  {
+    // Move the last tile of the list into the place of this one.
+    auto& cells = it->second;
+    const int pos = m_tile_index_pos[idx];
+    cells[pos] = cells.back();
+    m_tile_index_pos[cells[pos]] = pos;
+    cells.pop_back();
+  }
+
+  it = m_tile_index.find(id);
+  if (it != m_tile_index.end())
+  {
+    m_tile_index_pos[idx] = static_cast<int>(it->second.size());
+    it->second.push_back(idx);
+  }
+}
+
+std::vector<int>&
+TileMap::get_tile_cells(uint32_t id)
+{
+  auto it = m_tile_index.find(id);
+  if (it != m_tile_index.end())
+    return it->second;
 
-      change(x,y,newtile);
+  m_tile_index_pos.resize(m_tiles.size());
+
+  std::vector<int>& cells = m_tile_index[id];
+  for (int idx = 0; idx < static_cast<int>(m_tiles.size()); ++idx)
+  {
+    if (m_tiles[idx] == id)
+    {
+      m_tile_index_pos[idx] = static_cast<int>(cells.size());
+      cells.push_back(idx);
     }
   }
+  return cells;
 }
 
 void
@@ -836,7 +928,7 @@ TileMap::autotile(const Vector& pos, uint32_t tile, AutotileSet* autotileset)
   else
   {
     const int pos_x = static_cast<int>(pos.x), pos_y = static_cast<int>(pos.y);
-    m_tiles[pos_y*m_width + pos_x] = tile;
+    set_tile(pos_y*m_width + pos_x, tile);
 
     for (int y = static_cast<int>(pos_y) - 1; y <= static_cast<int>(pos_y) + 1; y++)
     {
@@ -867,17 +959,61 @@ TileMap::autotile_single(int x, int y, AutotileSet* autotileset)
 {
   // autotile() and autotile_erase() already perform validity checks for x, y and autotileset.
 
-  m_tiles[y*m_width + x] = autotileset->get_autotile(m_tiles[y*m_width + x],
-    autotileset->is_solid(get_tile_id(x-1, y-1)),
-    autotileset->is_solid(get_tile_id(x  , y-1)),
-    autotileset->is_solid(get_tile_id(x+1, y-1)),
-    autotileset->is_solid(get_tile_id(x-1, y  )),
-    autotileset->is_solid(get_tile_id(x  , y  )),
-    autotileset->is_solid(get_tile_id(x+1, y  )),
-    autotileset->is_solid(get_tile_id(x-1, y+1)),
-    autotileset->is_solid(get_tile_id(x  , y+1)),
-    autotileset->is_solid(get_tile_id(x+1, y+1)),
-    x, y);
+  // Neighbours outside of the tilemap repeat its border, like get_tile_id() does.
+  auto solid = [this, autotileset](int tx, int ty) {
+    return autotileset->is_solid(m_tiles[std::clamp(ty, 0, m_height - 1) * m_width +
+                                         std::clamp(tx, 0, m_width - 1)]);
+  };
+
+  const uint8_t mask = autotileset->get_mask(solid(x-1, y-1), solid(x, y-1), solid(x+1, y-1),
+                                             solid(x-1, y  ),                solid(x+1, y  ),
+                                             solid(x-1, y+1), solid(x, y+1), solid(x+1, y+1));
+  set_tile(y*m_width + x, autotileset->get_autotile(mask, solid(x, y), x, y));
+}
+
+void
+TileMap::autotile_region(const Rect& region, AutotileSet* autotileset)
+{
+  if (!autotileset || autotileset->is_corner())
+    return;
+
+  const int left = std::max(region.left, 0);
+  const int top = std::max(region.top, 0);
+  const int right = std::min(region.right, m_width);
+  const int bottom = std::min(region.bottom, m_height);
+
+  for (int y = top; y < bottom; ++y)
+  {
+    for (int x = left; x < right; ++x)
+    {
+      // Do not touch tiles that are not a part of the current autotileset.
+      const uint32_t current_tile = m_tiles[y*m_width + x];
+      if (current_tile != 0 && !autotileset->is_member(current_tile))
+        continue;
+
+      autotile_single(x, y, autotileset);
+    }
+  }
+}
+
+void
+TileMap::autotile_cells(const std::vector<int>& cells, AutotileSet* autotileset)
+{
+  if (!autotileset || autotileset->is_corner())
+    return;
+
+  for (int idx : cells)
+  {
+    if (idx < 0 || idx >= static_cast<int>(m_tiles.size()))
+      continue;
+
+    // Do not touch tiles that are not a part of the current autotileset.
+    const uint32_t current_tile = m_tiles[idx];
+    if (current_tile != 0 && !autotileset->is_member(current_tile))
+      continue;
+
+    autotile_single(idx % m_width, idx / m_width, autotileset);
+  }
 }
 
 void
@@ -904,7 +1040,7 @@ TileMap::autotile_single_corner(int x, int y, AutotileSet* autotileset, Autotile
   else if (op == AutotileCornerOperation::ADD_BOTTOM_LEFT) mask = static_cast<uint8_t>(mask | 0x02);
   else if (op == AutotileCornerOperation::ADD_BOTTOM_RIGHT) mask = static_cast<uint8_t>(mask | 0x01);
 
-  m_tiles[y*m_width + x] = (!mask) ? 0 : autotileset->get_autotile(current_tile,
+  set_tile(y*m_width + x, (!mask) ? 0 : autotileset->get_autotile(current_tile,
     (mask & 0x08) != 0,
     false,
     (mask & 0x04) != 0,
@@ -914,7 +1050,7 @@ TileMap::autotile_single_corner(int x, int y, AutotileSet* autotileset, Autotile
     (mask & 0x02) != 0,
     false,
     (mask & 0x01) != 0,
-    x, y);
+    x, y));
 }
 
 void
@@ -952,7 +1088,7 @@ TileMap::autotile_erase(const Vector& pos, AutotileSet* autotileset)
     if (current_tile != 0 && !autotileset->is_member(current_tile))
       return;
 
-    m_tiles[pos_y*m_width + pos_x] = 0;
+    set_tile(pos_y*m_width + pos_x, 0);
 
     for (int y = pos_y - 1; y <= pos_y + 1; y++)
     {
@@ -19,6 +19,7 @@
 #include "editor/layer_object.hpp"
 
 #include <algorithm>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "math/rect.hpp"
@@ -207,6 +208,7 @@ public:
   /**
    * @scripting
    * @description Changes all tiles with the given ID.
+                  Repeated calls only touch the affected tiles, which makes swapping tiles back and forth cheap.
    * @param int $oldtile
    * @param int $newtile
    */
@@ -218,6 +220,15 @@ public:
   /** Erases in autotile mode */
   void autotile_erase(const Vector& pos, AutotileSet* autotileset);
 
+  /** Recomputes every cell of \a region (in tiles) exactly once, after
+      a whole area was painted. Tiles of other autotilesets are left
+      alone. Corner-based tiles keep their corners in the tile itself,
+      so there is nothing to recompute for them. */
+  void autotile_region(const Rect& region, AutotileSet* autotileset);
+
+  /** Same as autotile_region(), for the given tile indices */
+  void autotile_cells(const std::vector<int>& cells, AutotileSet* autotileset);
+
   /** Returns the Autotilesets associated with the given tile */
   std::vector<AutotileSet*> get_autotilesets(uint32_t tile) const;
 
@@ -267,6 +278,11 @@ public:
 
   inline void set_tileset(const TileSet* tileset) { m_tileset = tileset; }
 
+  /** Returns a number that changes whenever a tile is changed. It is
+      unique across tilemaps, so that caches of the tiles can tell two
+      tilemaps apart, even when one took the place of the other. */
+  inline uint32_t get_revision() const { return m_revision; }
+
   inline const std::vector<uint32_t>& get_tiles() const { return m_tiles; }
 
 private:
@@ -293,6 +309,13 @@ private:
   void apply_offset_x(int fill_id, int xoffset);
   void apply_offset_y(int fill_id, int yoffset);
 
+  /** Writes a single tile, keeping the tile index up to date */
+  void set_tile(int idx, uint32_t id);
+
+  /** Returns the indices of all tiles with the given ID, scanning the
+      tilemap only the first time the ID is asked for */
+  std::vector<int>& get_tile_cells(uint32_t id);
+
 public:
   bool m_editor_active;
 
@@ -302,6 +325,17 @@ private:
   typedef std::vector<uint32_t> Tiles;
   Tiles m_tiles;
 
+  /** Inverse index from tile ID to the tiles holding it, only for the
+      IDs that change_all() was used with. Single tile changes keep it
+      current, bulk edits (resize, flip, set) simply drop it. */
+  std::unordered_map<uint32_t, std::vector<int>> m_tile_index;
+
+  /** Position of each tile in the m_tile_index list of its ID, if that
+      ID is indexed, so that a tile is removed from it in constant time */
+  std::vector<int> m_tile_index_pos;
+
+  uint32_t m_revision;
+
 #ifdef DOXYGEN_SCRIPTING
   /**
    * @scripting
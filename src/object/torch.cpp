@@ -40,6 +40,9 @@ Torch::Torch(const ReaderMapping& reader) :
   std::vector<float> vColor;
   if (!reader.get("color", vColor)) vColor = { 1.f, 1.f, 1.f };
 
+  m_flame->set_synchronized(true);
+  m_flame_glow->set_synchronized(true);
+  m_flame_light->set_synchronized(true);
   m_flame_glow->set_blend(Blend::ADD);
   m_flame_light->set_blend(Blend::ADD);
   if (vColor.size() >= 3)
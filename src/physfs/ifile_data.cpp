@@ -0,0 +1,172 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "physfs/ifile_data.hpp"
+
+#include <physfs.h>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define IFILE_DATA_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "physfs/util.hpp"
+
+namespace {
+
+std::string strip_leading_slash(const std::string& path)
+{
+  size_t start = path.find_first_not_of('/');
+  return start == std::string::npos ? std::string() : path.substr(start);
+}
+
+} // namespace
+
+IFileData::IFileData(const std::string& filename) :
+  m_data(),
+  m_size(0),
+  m_mapped(false),
+  m_buffer()
+{
+  // Check this as PHYSFS seems to be buggy and still returns a
+  // valid pointer in this case.
+  if (filename.empty()) {
+    throw std::runtime_error("Couldn't open file: empty filename");
+  }
+
+  PHYSFS_File* file = PHYSFS_openRead(filename.c_str());
+  if (file == nullptr) {
+    std::stringstream msg;
+    msg << "Couldn't open file '" << filename << "': "
+        << physfsutil::get_last_error();
+    throw std::runtime_error(msg.str());
+  }
+
+  load(file, filename);
+}
+
+IFileData::IFileData(PHYSFS_File* file, const std::string& filename) :
+  m_data(),
+  m_size(0),
+  m_mapped(false),
+  m_buffer()
+{
+  load(file, filename);
+}
+
+IFileData::~IFileData()
+{
+#ifdef IFILE_DATA_MMAP
+  if (m_mapped) {
+    munmap(const_cast<char*>(m_data), m_size);
+  }
+#endif
+}
+
+void
+IFileData::load(PHYSFS_File* file, const std::string& filename)
+{
+  if (map(filename)) {
+    PHYSFS_close(file);
+    return;
+  }
+
+  PHYSFS_sint64 length = PHYSFS_fileLength(file);
+  if (length < 0) {
+    PHYSFS_close(file);
+    std::stringstream msg;
+    msg << "Couldn't determine length of '" << filename << "': "
+        << physfsutil::get_last_error();
+    throw std::runtime_error(msg.str());
+  }
+
+  m_buffer.resize(static_cast<size_t>(length));
+  PHYSFS_sint64 bytesread = PHYSFS_readBytes(file, m_buffer.data(), m_buffer.size());
+  PHYSFS_close(file);
+  if (bytesread != length) {
+    std::stringstream msg;
+    msg << "Couldn't read '" << filename << "': "
+        << physfsutil::get_last_error();
+    throw std::runtime_error(msg.str());
+  }
+
+  m_data = m_buffer.data();
+  m_size = m_buffer.size();
+}
+
+bool
+IFileData::map([[maybe_unused]] const std::string& filename)
+{
+#ifdef IFILE_DATA_MMAP
+  // Only files living in a plain directory have a native path, archive
+  // members have to go through PhysFS.
+  const char* realdir = PHYSFS_getRealDir(filename.c_str());
+  if (realdir == nullptr) {
+    return false;
+  }
+
+  std::error_code ec;
+  if (!std::filesystem::is_directory(realdir, ec)) {
+    return false;
+  }
+
+  std::string path = strip_leading_slash(filename);
+  const char* mount_point = PHYSFS_getMountPoint(realdir);
+  if (mount_point != nullptr) {
+    std::string prefix = strip_leading_slash(mount_point);
+    if (!prefix.empty() && prefix.back() != '/') {
+      prefix += '/';
+    }
+    if (path.compare(0, prefix.size(), prefix) != 0) {
+      return false;
+    }
+    path.erase(0, prefix.size());
+  }
+
+  const std::string native_path = (std::filesystem::path(realdir) / path).string();
+  int fd = open(native_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+
+  // mmap() refuses empty files, those take the (trivial) read path.
+  struct stat st;
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) {
+    close(fd);
+    return false;
+  }
+
+  void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    return false;
+  }
+
+  m_data = static_cast<const char*>(addr);
+  m_size = static_cast<size_t>(st.st_size);
+  m_mapped = true;
+  return true;
+#else
+  return false;
+#endif
+}
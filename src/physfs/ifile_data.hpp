@@ -0,0 +1,64 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <stddef.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct PHYSFS_File;
+
+/** Read-only view of the complete contents of a PhysFS file. Files
+    that live in a plain directory are memory-mapped, everything else
+    (archives, platforms without mmap) is read with a single bulk
+    read. Either way the bytes are available without further copies
+    for as long as the object lives. */
+class IFileData final
+{
+public:
+  /** Opens 'filename', throws std::runtime_error on failure */
+  IFileData(const std::string& filename);
+
+  /** Takes ownership of an already opened 'file', 'filename' is the
+      PhysFS path it was opened from */
+  IFileData(PHYSFS_File* file, const std::string& filename);
+
+  ~IFileData();
+
+  const char* data() const { return m_data; }
+  size_t size() const { return m_size; }
+  std::string_view view() const { return std::string_view(m_data, m_size); }
+
+  /** Whether the contents are mapped instead of copied */
+  bool is_mapped() const { return m_mapped; }
+
+private:
+  void load(PHYSFS_File* file, const std::string& filename);
+  bool map(const std::string& filename);
+
+private:
+  const char* m_data;
+  size_t m_size;
+  bool m_mapped;
+  std::vector<char> m_buffer;
+
+private:
+  IFileData(const IFileData&) = delete;
+  IFileData& operator=(const IFileData&) = delete;
+};
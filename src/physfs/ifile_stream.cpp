@@ -18,8 +18,9 @@
 
 #include "physfs/ifile_streambuf.hpp"
 
-IFileStream::IFileStream(const std::string& filename) :
-  std::istream(nullptr), sb(new IFileStreambuf(filename))
+IFileStream::IFileStream(const std::string& filename, size_t buffer_size) :
+  std::istream(nullptr),
+  sb(new IFileStreambuf(filename, buffer_size > 0 ? buffer_size : IFileStreambuf::DEFAULT_BUFFER_SIZE))
 {
   init(sb.get());
 }
@@ -25,7 +25,8 @@ protected:
   std::unique_ptr<std::streambuf> sb;
 
 public:
-  IFileStream(const std::string& filename);
+  /** 0 selects the streambuf's default buffer size */
+  IFileStream(const std::string& filename, size_t buffer_size = 0);
 
 private:
   IFileStream(const IFileStream&) = delete;
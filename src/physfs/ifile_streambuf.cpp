@@ -16,6 +16,7 @@
 
 #include "physfs/ifile_streambuf.hpp"
 
+#include <algorithm>
 #include <assert.h>
 #include <physfs.h>
 #include <sstream>
@@ -23,9 +24,9 @@
 
 #include "physfs/util.hpp"
 
-IFileStreambuf::IFileStreambuf(const std::string& filename) :
+IFileStreambuf::IFileStreambuf(const std::string& filename, size_t buffer_size) :
   file(),
-  buf()
+  buf(std::max<size_t>(buffer_size, 1))
 {
   // Check this as PHYSFS seems to be buggy and still returns a
   // valid pointer in this case.
@@ -53,11 +54,11 @@ IFileStreambuf::underflow()
     return traits_type::eof();
   }
 
-  PHYSFS_sint64 bytesread = PHYSFS_readBytes(file, buf, sizeof(buf));
+  PHYSFS_sint64 bytesread = PHYSFS_readBytes(file, buf.data(), buf.size());
   if (bytesread <= 0) {
     return traits_type::eof();
   }
-  setg(buf, buf, buf + bytesread);
+  setg(buf.data(), buf.data(), buf.data() + bytesread);
 
   return static_cast<unsigned char>(buf[0]);
 }
@@ -70,7 +71,7 @@ IFileStreambuf::seekpos(pos_type pos, std::ios_base::openmode)
   }
 
   // The seek invalidated the buffer.
-  setg(buf, buf, buf);
+  setg(buf.data(), buf.data(), buf.data());
   return pos;
 }
 
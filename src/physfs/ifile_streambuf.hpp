@@ -17,6 +17,8 @@
 #pragma once
 
 #include <streambuf>
+#include <string>
+#include <vector>
 
 struct PHYSFS_File;
 
@@ -26,7 +28,12 @@ struct PHYSFS_File;
 class IFileStreambuf final : public std::streambuf
 {
 public:
-  IFileStreambuf(const std::string& filename);
+  /** Size of the buffer used when none is given, larger buffers mean
+      fewer PhysFS calls per file */
+  static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+public:
+  IFileStreambuf(const std::string& filename, size_t buffer_size = DEFAULT_BUFFER_SIZE);
   ~IFileStreambuf() override;
 
 protected:
@@ -37,7 +44,7 @@ protected:
 
 private:
   PHYSFS_File* file;
-  char buf[1024];
+  std::vector<char> buf;
 
 private:
   IFileStreambuf(const IFileStreambuf&) = delete;
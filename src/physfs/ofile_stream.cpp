@@ -18,8 +18,9 @@
 
 #include "physfs/ofile_streambuf.hpp"
 
-OFileStream::OFileStream(const std::string& filename) :
-  std::ostream(nullptr), sb(new OFileStreambuf(filename))
+OFileStream::OFileStream(const std::string& filename, size_t buffer_size) :
+  std::ostream(nullptr),
+  sb(new OFileStreambuf(filename, buffer_size > 0 ? buffer_size : OFileStreambuf::DEFAULT_BUFFER_SIZE))
 {
   init(sb.get());
 }
@@ -25,7 +25,8 @@ protected:
   std::unique_ptr<std::streambuf> sb;
 
 public:
-  OFileStream(const std::string& filename);
+  /** 0 selects the streambuf's default buffer size */
+  OFileStream(const std::string& filename, size_t buffer_size = 0);
 
 private:
   OFileStream(const OFileStream&) = delete;
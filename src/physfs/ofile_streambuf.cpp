@@ -16,14 +16,16 @@
 
 #include "physfs/ofile_streambuf.hpp"
 
+#include <algorithm>
 #include <physfs.h>
 #include <sstream>
 #include <stdexcept>
 
 #include "physfs/util.hpp"
 
-OFileStreambuf::OFileStreambuf(const std::string& filename) :
-  file()
+OFileStreambuf::OFileStreambuf(const std::string& filename, size_t buffer_size) :
+  file(),
+  buf(std::max<size_t>(buffer_size, 1))
 {
   file = PHYSFS_openWrite(filename.c_str());
   if (file == nullptr) {
@@ -33,7 +35,7 @@ OFileStreambuf::OFileStreambuf(const std::string& filename) :
     throw std::runtime_error(msg.str());
   }
 
-  setp(buf, buf+sizeof(buf));
+  setp(buf.data(), buf.data() + buf.size());
 }
 
 OFileStreambuf::~OFileStreambuf()
@@ -61,7 +63,7 @@ OFileStreambuf::overflow(int c)
       return traits_type::eof();
   }
 
-  setp(buf, buf + res);
+  setp(buf.data(), buf.data() + buf.size());
   return 0;
 }
 
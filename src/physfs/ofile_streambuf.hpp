@@ -17,13 +17,20 @@
 #pragma once
 
 #include <streambuf>
+#include <string>
+#include <vector>
 
 struct PHYSFS_File;
 
 class OFileStreambuf final : public std::streambuf
 {
 public:
-  OFileStreambuf(const std::string& filename);
+  /** Size of the buffer used when none is given, larger buffers mean
+      fewer PhysFS calls per file */
+  static constexpr size_t DEFAULT_BUFFER_SIZE = 64 * 1024;
+
+public:
+  OFileStreambuf(const std::string& filename, size_t buffer_size = DEFAULT_BUFFER_SIZE);
   ~OFileStreambuf() override;
 
 protected:
@@ -32,7 +39,7 @@ protected:
 
 private:
   PHYSFS_File* file;
-  char buf[1024];
+  std::vector<char> buf;
 
 private:
   OFileStreambuf(const OFileStreambuf&) = delete;
@@ -34,6 +34,7 @@ Sprite::Sprite(SpriteData& newdata) :
   m_color(1.0f, 1.0f, 1.0f, 1.0f),
   m_blend(),
   m_is_paused(false),
+  m_synchronized(false),
   m_action(m_data.get_action("default"))
 {
   if (!m_action)
@@ -52,6 +53,7 @@ Sprite::Sprite(const Sprite& other) :
   m_color(1.0f, 1.0f, 1.0f, 1.0f),
   m_blend(),
   m_is_paused(other.m_is_paused),
+  m_synchronized(other.m_synchronized),
   m_action(other.m_action)
 {
 }
@@ -143,6 +145,12 @@ Sprite::update()
 
   if (m_is_paused) return;
 
+  if (m_synchronized && m_animation_loops < 0)
+  {
+    m_frameidx = m_action->get_synchronized_frame();
+    return;
+  }
+
   m_frame += frame_inc;
 
   while (m_frame >= 1.0f) {
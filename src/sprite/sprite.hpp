@@ -72,6 +72,13 @@ public:
   void pause_animation() { m_is_paused = true; }
   void resume_animation() { m_is_paused = false; }
 
+  /** Plays endlessly looping actions in step with every other
+      synchronized sprite, following the SpriteManager's animation clock
+      instead of starting when the action is set. Their frame is then
+      resolved once per frame for all of them. Meant for decorations
+      which don't need an animation of their own. */
+  inline void set_synchronized(bool synchronized) { m_synchronized = synchronized; }
+
   /** Check if animation is stopped or not */
   bool animation_done() const;
 
@@ -141,6 +148,7 @@ private:
   Color m_color;
   Blend m_blend;
   bool m_is_paused;
+  bool m_synchronized;
 
   const SpriteData::Action* m_action;
 
@@ -24,6 +24,7 @@
 #include <sexp/io.hpp>
 #include <sexp/value.hpp>
 
+#include "sprite/sprite_manager.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 #include "util/reader_collection.hpp"
@@ -46,10 +47,31 @@ SpriteData::Action::Action() :
   loop_frame(1),
   has_custom_loops(false),
   family_name(),
-  surfaces()
+  surfaces(),
+  synchronized_tick(0),
+  synchronized_frame(0)
 {
 }
 
+int
+SpriteData::Action::get_synchronized_frame() const
+{
+  const SpriteManager& sprite_manager = *SpriteManager::current();
+  if (synchronized_tick != sprite_manager.get_animation_tick())
+  {
+    synchronized_tick = sprite_manager.get_animation_tick();
+
+    // Like Sprite::update(), play all frames once, then loop from loop_frame.
+    const int frames = static_cast<int>(surfaces.size());
+    const int loop_start = std::clamp(loop_frame - 1, 0, std::max(frames - 1, 0));
+    int frame = static_cast<int>(sprite_manager.get_animation_time() * fps);
+    if (frame >= frames)
+      frame = loop_start + (frame - frames) % std::max(frames - loop_start, 1);
+    synchronized_frame = frame;
+  }
+  return synchronized_frame;
+}
+
 void
 SpriteData::Action::reset(SurfacePtr surface)
 {
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -41,6 +42,10 @@ private:
 
     void reset(SurfacePtr surface);
 
+    /** Frame of the animation if it had been looping since the start of
+        the animation clock, shared by all synchronized sprites */
+    int get_synchronized_frame() const;
+
     std::string name;
 
     /** Position correction */
@@ -76,6 +81,10 @@ private:
     std::string family_name;
 
     std::vector<SurfacePtr> surfaces;
+
+    /** get_synchronized_frame() is resolved once per animation tick */
+    mutable uint32_t synchronized_tick;
+    mutable int synchronized_frame;
   };
 
 private:
@@ -18,9 +18,12 @@
 #include "sprite/sprite_manager.hpp"
 
 #include "sprite/sprite.hpp"
+#include "supertux/globals.hpp"
 
 SpriteManager::SpriteManager() :
-  m_sprites()
+  m_sprites(),
+  m_animation_time(0.0f),
+  m_animation_tick(1)
 {
 }
 
@@ -55,3 +58,10 @@ SpriteManager::reload()
   for (const auto& sprite_data : m_sprites)
     sprite_data.second->load();
 }
+
+void
+SpriteManager::update_animation_clock()
+{
+  m_animation_time = g_game_time;
+  ++m_animation_tick;
+}
@@ -19,6 +19,7 @@
 
 #include "util/currenton.hpp"
 
+#include <stdint.h>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -33,6 +34,9 @@ private:
   typedef std::unordered_map<std::string, std::unique_ptr<SpriteData>> Sprites;
   Sprites m_sprites;
 
+  float m_animation_time;
+  uint32_t m_animation_tick;
+
 public:
   SpriteManager();
 
@@ -42,6 +46,16 @@ public:
   /** Reloads all sprites. */
   void reload();
 
+  /** Advances the animation clock shared by synchronized sprites and
+      animated tiles, called once before a frame is drawn */
+  void update_animation_clock();
+
+  inline float get_animation_time() const { return m_animation_time; }
+
+  /** Changes whenever the animation clock advances, so that animation
+      frames can be resolved once per frame and cached */
+  inline uint32_t get_animation_tick() const { return m_animation_tick; }
+
 private:
   SpriteData* load(const std::string& filename);
 
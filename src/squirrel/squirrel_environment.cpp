@@ -26,11 +26,22 @@
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 
+namespace {
+
+/** Maximum number of finished threads an environment keeps for reuse */
+const size_t MAX_POOLED_THREADS = 16;
+
+} // namespace
+
+int SquirrelEnvironment::s_alive_threads = 0;
+int SquirrelEnvironment::s_pooled_threads = 0;
+
 SquirrelEnvironment::SquirrelEnvironment(ssq::VM& vm, const std::string& name) :
   m_vm(vm),
   m_table(m_vm.newTable()),
   m_name(name),
   m_scripts(),
+  m_thread_pool(),
   m_scheduler(std::make_unique<SquirrelScheduler>(m_vm))
 {
   // Set the root table as delegate.
@@ -39,7 +50,11 @@ SquirrelEnvironment::SquirrelEnvironment(ssq::VM& vm, const std::string& name) :
 
 SquirrelEnvironment::~SquirrelEnvironment()
 {
+  s_alive_threads -= static_cast<int>(m_scripts.size());
+  s_pooled_threads -= static_cast<int>(m_thread_pool.size());
+
   m_scripts.clear();
+  m_thread_pool.clear();
   m_table.reset();
 }
 
@@ -101,33 +116,68 @@ SquirrelEnvironment::run_script(const std::string& script, const std::string& so
 void
 SquirrelEnvironment::garbage_collect()
 {
-  m_scripts.erase(
-    std::remove_if(m_scripts.begin(), m_scripts.end(),
-                   [](ssq::VM& thread) {
-                     return thread.getState() != SQ_VMSTATE_SUSPENDED;
-                   }),
-    m_scripts.end());
+  auto it = std::partition(m_scripts.begin(), m_scripts.end(),
+                           [](ssq::VM& thread) {
+                             return thread.getState() == SQ_VMSTATE_SUSPENDED;
+                           });
+
+  for (auto finished = it; finished != m_scripts.end(); ++finished)
+  {
+    // Threads can still be running when a script runs another script.
+    if (finished->getState() == SQ_VMSTATE_IDLE &&
+        m_thread_pool.size() < MAX_POOLED_THREADS)
+      m_thread_pool.push_back(std::move(*finished));
+  }
+
+  s_alive_threads -= static_cast<int>(std::distance(it, m_scripts.end()));
+  m_scripts.erase(it, m_scripts.end());
 }
 
 void
 SquirrelEnvironment::run_script(std::istream& in, const std::string& sourcename)
 {
+  const int pooled_threads = static_cast<int>(m_thread_pool.size());
+
   garbage_collect();
 
   try
   {
-    ssq::VM thread = m_vm.newThread(64);
-    thread.setForeignPtr(this);
-    thread.setRootTable(m_table);
+    ssq::VM thread = [this]{
+      if (m_thread_pool.empty())
+      {
+        ssq::VM new_thread = m_vm.newThread(64);
+        new_thread.setForeignPtr(this);
+        new_thread.setRootTable(m_table);
+        return new_thread;
+      }
+
+      // Finished threads keep whatever their last script left on the
+      // stack, clear it before reusing them.
+      ssq::VM pooled_thread = std::move(m_thread_pool.back());
+      m_thread_pool.pop_back();
+      sq_settop(pooled_thread.getHandle(), 0);
+      return pooled_thread;
+    }();
 
     thread.run(thread.compileSource(in, sourcename.c_str()), true);
 
-    m_scripts.push_back(std::move(thread));
+    if (thread.getState() == SQ_VMSTATE_SUSPENDED)
+    {
+      m_scripts.push_back(std::move(thread));
+      s_alive_threads += 1;
+    }
+    else if (thread.getState() == SQ_VMSTATE_IDLE &&
+             m_thread_pool.size() < MAX_POOLED_THREADS)
+    {
+      m_thread_pool.push_back(std::move(thread));
+    }
   }
   catch (const std::exception& err)
   {
     log_warning << err.what() << std::endl;
   }
+
+  s_pooled_threads += static_cast<int>(m_thread_pool.size()) - pooled_threads;
 }
 
 SQInteger
@@ -32,6 +32,14 @@
     variables. */
 class SquirrelEnvironment final
 {
+public:
+  /** Number of script threads that are still running (i.e. suspended),
+      over all environments */
+  static int s_alive_threads;
+
+  /** Number of finished threads kept for reuse, over all environments */
+  static int s_pooled_threads;
+
 public:
   SquirrelEnvironment(ssq::VM& vm, const std::string& name);
   ~SquirrelEnvironment();
@@ -62,6 +70,7 @@ public:
   SQInteger skippable_wait_for_seconds(HSQUIRRELVM vm, float seconds);
 
 private:
+  /** Moves finished threads from m_scripts into m_thread_pool */
   void garbage_collect();
 
 private:
@@ -69,6 +78,7 @@ private:
   ssq::Table m_table;
   std::string m_name;
   std::vector<ssq::VM> m_scripts;
+  std::vector<ssq::VM> m_thread_pool;
   std::unique_ptr<SquirrelScheduler> m_scheduler;
 
 private:
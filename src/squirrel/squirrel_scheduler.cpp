@@ -17,58 +17,207 @@
 #include "squirrel/squirrel_scheduler.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 #include <simplesquirrel/exceptions.hpp>
 
 #include "squirrel/squirrel_util.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
+#include "supertux/constants.hpp"
 #include "supertux/level.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
+
+namespace {
+
+int64_t time_to_tick(float time)
+{
+  return static_cast<int64_t>(std::floor(time * LOGICAL_FPS));
+}
+
+} // namespace
+
+int SquirrelScheduler::s_scheduled_threads = 0;
+int SquirrelScheduler::s_resumed_threads = 0;
+int SquirrelScheduler::s_resumed_threads_last_frame = 0;
+
+void
+SquirrelScheduler::end_frame()
+{
+  s_resumed_threads_last_frame = s_resumed_threads;
+  s_resumed_threads = 0;
+}
 
 SquirrelScheduler::SquirrelScheduler(ssq::VM& vm) :
   m_vm(vm),
-  schedule()
+  m_wheel(),
+  m_overflow(),
+  m_due(),
+  m_current_tick(-1),
+  m_size(0)
+{
+}
+
+SquirrelScheduler::~SquirrelScheduler()
+{
+  s_scheduled_threads -= m_size;
+}
+
+void
+SquirrelScheduler::insert(ScheduleEntry entry)
 {
+  if (m_current_tick < 0 || entry.wakeup_tick < m_current_tick)
+  {
+    m_due.push_back(entry);
+    return;
+  }
+
+  const int64_t delta = entry.wakeup_tick - m_current_tick;
+  for (int level = 0; level < WHEEL_LEVELS; ++level)
+  {
+    if (delta < (int64_t(1) << (WHEEL_BITS * (level + 1))))
+    {
+      const int slot = static_cast<int>((entry.wakeup_tick >> (WHEEL_BITS * level)) & (WHEEL_SIZE - 1));
+      m_wheel[level][slot].push_back(entry);
+      return;
+    }
+  }
+
+  m_overflow.push_back(entry);
+}
+
+void
+SquirrelScheduler::cascade(int level)
+{
+  if (level >= WHEEL_LEVELS)
+  {
+    Slot overflow = std::move(m_overflow);
+    m_overflow.clear();
+    for (const auto& entry : overflow)
+      insert(entry);
+    return;
+  }
+
+  const int slot = static_cast<int>((m_current_tick >> (WHEEL_BITS * level)) & (WHEEL_SIZE - 1));
+
+  // Cascade the higher levels first, so that their entries end up in
+  // this level before it gets redistributed.
+  if (slot == 0)
+    cascade(level + 1);
+
+  Slot entries = std::move(m_wheel[level][slot]);
+  m_wheel[level][slot].clear();
+  for (const auto& entry : entries)
+    insert(entry);
+}
+
+void
+SquirrelScheduler::collect_skippable(Slot& slot)
+{
+  auto it = std::stable_partition(slot.begin(), slot.end(),
+                                  [](const ScheduleEntry& entry) {
+                                    return !entry.skippable;
+                                  });
+  m_due.insert(m_due.end(), it, slot.end());
+  slot.erase(it, slot.end());
 }
 
 void
 SquirrelScheduler::update(float time)
 {
-  while (!schedule.empty() &&
-         (schedule.front().wakeup_time < time ||
-          (schedule.front().skippable && Level::current() &&
-           Level::current()->m_skip_cutscene)))
+  PROFILE_ZONE("SquirrelScheduler::update");
+
+  const int64_t target_tick = time_to_tick(time);
+
+  if (m_current_tick < 0)
+    m_current_tick = target_tick;
+
+  // Move all entries of the ticks that passed into m_due. When nothing
+  // is left in the wheel, jump ahead instead of visiting every slot.
+  while (m_current_tick <= target_tick)
   {
-    HSQOBJECT thread_ref = schedule.front().thread_ref;
-
-    sq_pushobject(m_vm.getHandle(), thread_ref);
-    sq_getweakrefval(m_vm.getHandle(), -1);
-
-    HSQUIRRELVM scheduled_vm;
-    if (sq_gettype(m_vm.getHandle(), -1) == OT_THREAD &&
-       SQ_SUCCEEDED(sq_getthread(m_vm.getHandle(), -1, &scheduled_vm))) {
-      if (SQ_FAILED(sq_wakeupvm(scheduled_vm, SQFalse, SQFalse, SQTrue, SQFalse))) {
-        std::ostringstream msg;
-        msg << "Error waking VM: ";
-        sq_getlasterror(scheduled_vm);
-        if (sq_gettype(scheduled_vm, -1) != OT_STRING) {
-          msg << "(no info)";
-        } else {
-          const char* lasterr;
-          sq_getstring(scheduled_vm, -1, &lasterr);
-          msg << lasterr;
-        }
-        log_warning << msg.str() << std::endl;
-        sq_pop(scheduled_vm, 1);
-      }
+    if (m_size == static_cast<int>(m_due.size()))
+    {
+      m_current_tick = target_tick + 1;
+      break;
     }
 
-    sq_release(m_vm.getHandle(), &thread_ref);
-    sq_pop(m_vm.getHandle(), 2);
+    if (m_current_tick > 0 && (m_current_tick & (WHEEL_SIZE - 1)) == 0)
+      cascade(1);
+
+    Slot& slot = m_wheel[0][m_current_tick & (WHEEL_SIZE - 1)];
+    m_due.insert(m_due.end(), slot.begin(), slot.end());
+    slot.clear();
+
+    m_current_tick += 1;
+  }
 
-    std::pop_heap(schedule.begin(), schedule.end());
-    schedule.pop_back();
+  const bool skip = Level::current() && Level::current()->m_skip_cutscene;
+  if (skip)
+  {
+    for (auto& level : m_wheel)
+      for (auto& slot : level)
+        collect_skippable(slot);
+    collect_skippable(m_overflow);
   }
+
+  if (m_due.empty())
+    return;
+
+  // Threads that are woken up might schedule themselves again, so work
+  // on a copy of the due entries.
+  Slot due = std::move(m_due);
+  m_due.clear();
+
+  std::stable_sort(due.begin(), due.end(),
+                   [](const ScheduleEntry& lhs, const ScheduleEntry& rhs) {
+                     return lhs.wakeup_time < rhs.wakeup_time;
+                   });
+
+  auto it = std::stable_partition(due.begin(), due.end(),
+                                  [time, skip](const ScheduleEntry& entry) {
+                                    return entry.wakeup_time < time || (skip && entry.skippable);
+                                  });
+  m_due.insert(m_due.end(), it, due.end());
+  due.erase(it, due.end());
+
+  m_size -= static_cast<int>(due.size());
+  s_scheduled_threads -= static_cast<int>(due.size());
+
+  for (const auto& entry : due)
+    wakeup(entry);
+}
+
+void
+SquirrelScheduler::wakeup(const ScheduleEntry& entry)
+{
+  HSQOBJECT thread_ref = entry.thread_ref;
+
+  sq_pushobject(m_vm.getHandle(), thread_ref);
+  sq_getweakrefval(m_vm.getHandle(), -1);
+
+  HSQUIRRELVM scheduled_vm;
+  if (sq_gettype(m_vm.getHandle(), -1) == OT_THREAD &&
+     SQ_SUCCEEDED(sq_getthread(m_vm.getHandle(), -1, &scheduled_vm))) {
+    s_resumed_threads += 1;
+    if (SQ_FAILED(sq_wakeupvm(scheduled_vm, SQFalse, SQFalse, SQTrue, SQFalse))) {
+      std::ostringstream msg;
+      msg << "Error waking VM: ";
+      sq_getlasterror(scheduled_vm);
+      if (sq_gettype(scheduled_vm, -1) != OT_STRING) {
+        msg << "(no info)";
+      } else {
+        const char* lasterr;
+        sq_getstring(scheduled_vm, -1, &lasterr);
+        msg << lasterr;
+      }
+      log_warning << msg.str() << std::endl;
+      sq_pop(scheduled_vm, 1);
+    }
+  }
+
+  sq_release(m_vm.getHandle(), &thread_ref);
+  sq_pop(m_vm.getHandle(), 2);
 }
 
 SQInteger
@@ -84,13 +233,15 @@ SquirrelScheduler::schedule_thread(HSQUIRRELVM scheduled_vm, float time, bool sk
     throw ssq::Exception(m_vm.getHandle(), "Couldn't get thread weakref from vm");
   }
   entry.wakeup_time = time;
+  entry.wakeup_tick = time_to_tick(time);
   entry.skippable = skippable;
 
   sq_addref(m_vm.getHandle(), & entry.thread_ref);
   sq_pop(m_vm.getHandle(), 2);
 
-  schedule.push_back(entry);
-  std::push_heap(schedule.begin(), schedule.end());
+  insert(entry);
+  m_size += 1;
+  s_scheduled_threads += 1;
 
   return sq_suspendvm(scheduled_vm);
 }
@@ -16,22 +16,42 @@
 
 #pragma once
 
+#include <array>
+#include <stdint.h>
 #include <vector>
 
 #include <simplesquirrel/vm.hpp>
 
 /** This class keeps a list of squirrel threads that are scheduled for a certain
-    time. (the typical result of a wait() command in a squirrel script) */
+    time. (the typical result of a wait() command in a squirrel script)
+
+    Threads are kept in a hierarchical timer wheel with a resolution of
+    one logical frame, so scheduling and waking up a thread doesn't
+    depend on the number of other threads waiting. */
 class SquirrelScheduler final
 {
+public:
+  /** Number of currently scheduled threads, over all schedulers */
+  static int s_scheduled_threads;
+
+  /** Number of threads woken up since the last call to end_frame(),
+      over all schedulers */
+  static int s_resumed_threads;
+  static int s_resumed_threads_last_frame;
+
+  static void end_frame();
+
 public:
   SquirrelScheduler(ssq::VM& vm);
+  ~SquirrelScheduler();
 
   /** time must be absolute time, not relative updates, i.e. g_game_time */
   void update(float time);
 
   SQInteger schedule_thread(HSQUIRRELVM vm, float time, bool skippable);
 
+  inline int size() const { return m_size; }
+
 private:
   struct ScheduleEntry final
   {
@@ -39,21 +59,43 @@ private:
     HSQOBJECT thread_ref;
     /// time when the thread should be woken up
     float wakeup_time;
+    /// wakeup_time in ticks of the timer wheel
+    int64_t wakeup_tick;
     // true if calling force_wake_up should wake this entry up
     bool skippable;
-
-    bool operator<(const ScheduleEntry& other) const
-    {
-      // we need the smallest value on top
-      return wakeup_time > other.wakeup_time;
-    }
   };
 
+  static const int WHEEL_BITS = 6;
+  static const int WHEEL_SIZE = 1 << WHEEL_BITS;
+  static const int WHEEL_LEVELS = 4;
+
+  typedef std::vector<ScheduleEntry> Slot;
+
+private:
+  void insert(ScheduleEntry entry);
+  void cascade(int level);
+  void collect_skippable(Slot& slot);
+  void wakeup(const ScheduleEntry& entry);
+
 private:
   ssq::VM& m_vm;
 
-  typedef std::vector<ScheduleEntry> ScheduleHeap;
-  ScheduleHeap schedule;
+  /** m_wheel[level][slot], level 0 holds the entries of the next
+      WHEEL_SIZE ticks, every further level covers WHEEL_SIZE times
+      the range of the previous one */
+  std::array<std::array<Slot, WHEEL_SIZE>, WHEEL_LEVELS> m_wheel;
+
+  /** Entries that are too far in the future for the wheel */
+  Slot m_overflow;
+
+  /** Entries whose tick has been reached, but that aren't due yet
+      (or have been scheduled for a tick that already passed) */
+  Slot m_due;
+
+  /** The next tick that hasn't been moved into m_due yet */
+  int64_t m_current_tick;
+
+  int m_size;
 
 private:
   SquirrelScheduler(const SquirrelScheduler&) = delete;
@@ -119,6 +119,7 @@ void
 SquirrelVirtualMachine::update(float dt_sec)
 {
   update_debugger();
+  SquirrelScheduler::end_frame();
   m_scheduler->update(g_game_time);
 }
 
@@ -26,6 +26,8 @@
 #include "object/camera.hpp"
 #include "object/player.hpp"
 #include "physfs/ifile_stream.hpp"
+#include "squirrel/squirrel_environment.hpp"
+#include "squirrel/squirrel_scheduler.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
 #include "supertux/console.hpp"
 #include "supertux/debug.hpp"
@@ -41,6 +43,7 @@
 #include "supertux/sector.hpp"
 #include "supertux/textscroller_screen.hpp"
 #include "supertux/title_screen.hpp"
+#include "util/profiler.hpp"
 #include "worldmap/worldmap.hpp"
 
 namespace scripting {
@@ -335,6 +338,46 @@ static void debug_show_fps(bool enable)
 {
   g_config->show_fps = enable;
 }
+/**
+ * @scripting
+ * @description Enables/disables the profiler and its overlay.
+ * @param bool $enable
+ */
+static void debug_show_profiler(bool enable)
+{
+  g_debug.set_show_profiler(enable);
+}
+/**
+ * @scripting
+ * @description Writes the recently recorded profiler zones to ""filename"" in the user directory, in the Chrome trace event format.
+ * @param string $filename
+ */
+static bool debug_profiler_export(const std::string& filename)
+{
+  return Profiler::instance().export_chrome_trace(filename);
+}
+/**
+ * @scripting
+ * @description Prints the number of script threads that are alive, kept for reuse and waiting, and how many were resumed in the last frame.
+ */
+static void debug_script_stats()
+{
+  ConsoleBuffer::output << "Script threads: " << SquirrelEnvironment::s_alive_threads << " alive, "
+                        << SquirrelEnvironment::s_pooled_threads << " pooled, "
+                        << SquirrelScheduler::s_scheduled_threads << " scheduled, "
+                        << SquirrelScheduler::s_resumed_threads_last_frame << " resumed last frame" << std::endl;
+}
+/**
+ * @scripting
+ * @description Prints how many of the preallocated sound sources are in use, and how many sounds were played, stole a source or were dropped so far.
+ */
+static void debug_sound_stats()
+{
+  const auto& stats = SoundManager::current()->get_voice_stats();
+  ConsoleBuffer::output << "Sound sources: " << stats.active << "/" << stats.allocated << " in use, "
+                        << stats.played << " played, " << stats.stolen << " stolen, "
+                        << stats.dropped << " dropped" << std::endl;
+}
 /**
  * @scripting
  * @description Enables/disables drawing of non-solid layers.
@@ -844,6 +887,10 @@ void register_supertux_scripting_api(ssq::VM& vm)
   vm.addFunc("import", &scripting::Globals::import);
   vm.addFunc("debug_collrects", &scripting::Globals::debug_collrects);
   vm.addFunc("debug_show_fps", &scripting::Globals::debug_show_fps);
+  vm.addFunc("debug_show_profiler", &scripting::Globals::debug_show_profiler);
+  vm.addFunc("debug_profiler_export", &scripting::Globals::debug_profiler_export);
+  vm.addFunc("debug_script_stats", &scripting::Globals::debug_script_stats);
+  vm.addFunc("debug_sound_stats", &scripting::Globals::debug_sound_stats);
   vm.addFunc("debug_draw_solids_only", &scripting::Globals::debug_draw_solids_only);
   vm.addFunc("debug_draw_editor_images", &scripting::Globals::debug_draw_editor_images);
   vm.addFunc("debug_worldmap_ghost", &scripting::Globals::debug_worldmap_ghost);
@@ -127,8 +127,46 @@ AutotileSet::AutotileSet(const std::vector<Autotile*>& tiles, uint32_t default_t
   m_autotiles(tiles),
   m_default(default_tile),
   m_name(name),
-  m_corner(corner)
+  m_corner(corner),
+  m_solid_lookup(),
+  m_empty_lookup(),
+  m_members_base(0),
+  m_members()
 {
+  // Earlier autotiles win, as they did when scanning m_autotiles for
+  // every lookup.
+  for (auto it = m_autotiles.rbegin(); it != m_autotiles.rend(); ++it)
+  {
+    for (const auto& mask : (*it)->get_masks())
+    {
+      auto& lookup = mask.get_center() ? m_solid_lookup : m_empty_lookup;
+      lookup[mask.get_mask()] = *it;
+    }
+  }
+
+  uint32_t min_id = UINT32_MAX, max_id = 0;
+  for (const auto* autotile : m_autotiles)
+  {
+    min_id = std::min(min_id, autotile->get_tile_id());
+    max_id = std::max(max_id, autotile->get_tile_id());
+    for (const auto& pair : autotile->get_all_tile_ids())
+    {
+      min_id = std::min(min_id, pair.first);
+      max_id = std::max(max_id, pair.first);
+    }
+  }
+
+  if (min_id <= max_id)
+  {
+    m_members_base = min_id;
+    m_members.resize(max_id - min_id + 1);
+    for (auto it = m_autotiles.rbegin(); it != m_autotiles.rend(); ++it)
+    {
+      m_members[(*it)->get_tile_id() - m_members_base] = *it;
+      for (const auto& pair : (*it)->get_all_tile_ids())
+        m_members[pair.first - m_members_base] = *it;
+    }
+  }
 }
 
 AutotileSet::~AutotileSet()
@@ -171,6 +209,29 @@ AutotileSet::get_autotile(uint32_t tile_id,
     bool bottom_left, bool bottom, bool bottom_right,
     int x, int y
   ) const
+{
+  return get_autotile(get_mask(top_left, top, top_right, left, right,
+                               bottom_left, bottom, bottom_right),
+                      center, x, y);
+}
+
+uint32_t
+AutotileSet::get_autotile(uint8_t mask, bool center, int x, int y) const
+{
+  if (m_corner)
+    center = true;
+
+  const Autotile* autotile = (center ? m_solid_lookup : m_empty_lookup)[mask];
+  if (autotile)
+    return autotile->pick_tile(x, y);
+
+  return center ? get_default_tile() : 0;
+}
+
+uint8_t
+AutotileSet::get_mask(bool top_left, bool top, bool top_right,
+                      bool left, bool right,
+                      bool bottom_left, bool bottom, bool bottom_right) const
 {
   uint8_t num_mask = 0;
 
@@ -180,7 +241,6 @@ AutotileSet::get_autotile(uint32_t tile_id,
     if (bottom_left)  num_mask = static_cast<uint8_t>(num_mask + 0x02);
     if (top_right)    num_mask = static_cast<uint8_t>(num_mask + 0x04);
     if (top_left)     num_mask = static_cast<uint8_t>(num_mask + 0x08);
-    center = true;
   }
   else
   {
@@ -202,67 +262,31 @@ AutotileSet::get_autotile(uint32_t tile_id,
     if (top_left)     num_mask = static_cast<uint8_t>(num_mask + 0x80);
   }
 
-  for (auto* autotile : m_autotiles)
-  {
-    if (autotile->matches(num_mask, center))
-    {
-      return autotile->pick_tile(x, y);
-    }
-  }
+  return num_mask;
+}
 
-  return center ? get_default_tile() : 0;
+const Autotile*
+AutotileSet::find_autotile(uint32_t tile_id) const
+{
+  if (tile_id < m_members_base || tile_id - m_members_base >= m_members.size())
+    return nullptr;
+
+  return m_members[tile_id - m_members_base];
 }
 
 bool
 AutotileSet::is_member(uint32_t tile_id) const
 {
-  for (auto& tile : m_autotiles)
-  {
-    if (tile->get_tile_id() == tile_id)
-    {
-      return true;
-    }
-    else
-    {
-      for (const auto& pair : tile->get_all_tile_ids())
-      {
-        if (pair.first == tile_id)
-        {
-          return true;
-        }
-      }
-    }
-  }
   // m_default should *never* be 0 (always a valid solid tile,
   // even if said tile isn't part of the tileset).
-  return tile_id == m_default && m_default != 0;
+  return find_autotile(tile_id) || (tile_id == m_default && m_default != 0);
 }
 
 bool
 AutotileSet::is_solid(uint32_t tile_id) const
 {
-  if (!is_member(tile_id))
-    return false;
-
-  for (auto* tile : m_autotiles)
-  {
-    if (tile->get_tile_id() == tile_id)
-    {
-      return tile->is_solid();
-    }
-    else
-    {
-      for (const auto& pair : tile->get_all_tile_ids())
-      {
-        if (pair.first == tile_id)
-        {
-          return tile->is_solid();
-        }
-      }
-    }
-  }
-
-  //log_warning << "Called AutotileSet::is_solid() with a tile_id that isn't in the Autotileset, yet that returns is_member() = true." << std::endl;
+  if (const Autotile* autotile = find_autotile(tile_id))
+    return autotile->is_solid();
 
   // m_default should *never* be 0 (always a valid solid tile,
   // even if said tile isn't part of the tileset).
@@ -272,12 +296,8 @@ AutotileSet::is_solid(uint32_t tile_id) const
 uint8_t
 AutotileSet::get_mask_from_tile(uint32_t tile) const
 {
-  for (auto* autotile : m_autotiles)
-  {
-    if (autotile->is_amongst(tile)) {
-      return autotile->get_first_mask();
-    }
-  }
+  if (const Autotile* autotile = find_autotile(tile))
+    return autotile->get_first_mask();
   return static_cast<uint8_t>(0);
 }
 
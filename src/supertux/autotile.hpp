@@ -17,6 +17,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include <stdint.h>
 #include <string>
@@ -30,6 +31,7 @@ public:
   bool matches(uint8_t mask, bool center) const;
 
   inline uint8_t get_mask() const { return m_mask; }
+  inline bool get_center() const { return m_center; }
 
 private:
   uint8_t m_mask;
@@ -66,6 +68,8 @@ public:
   /** @returns the first accessible mask for that autotile */
   uint8_t get_first_mask() const;
 
+  inline const std::vector<AutotileMask>& get_masks() const { return m_masks; }
+
   /** Returns all possible tiles for this autotile */
   inline const std::vector<std::pair<uint32_t, AltConditions>>& get_all_tile_ids() const { return m_alt_tiles; }
 
@@ -104,6 +108,19 @@ public:
     int x, int y
   ) const;
 
+  /** Same as above, with the surrounding tiles already packed into a
+   *  mask, as get_mask() does.
+   */
+  uint32_t get_autotile(uint8_t mask, bool center, int x, int y) const;
+
+  /** Packs the solidity of the surrounding tiles into the mask that
+   *  autotiles are looked up by. For corner-based autotilesets only the
+   *  four corners count.
+   */
+  uint8_t get_mask(bool top_left, bool top, bool top_right,
+                   bool left, bool right,
+                   bool bottom_left, bool bottom, bool bottom_right) const;
+
   /** Returns the id of the first block in the autotileset. Used for erronous configs. */
   inline uint32_t get_default_tile() const { return m_default; }
 
@@ -127,6 +144,10 @@ public:
   //        one and only one corresponding tile.
   void validate(int32_t start, int32_t end) const;
 
+private:
+  /** Returns the first autotile that contains \a tile_id, if any */
+  const Autotile* find_autotile(uint32_t tile_id) const;
+
 public:
   static std::vector<std::unique_ptr<AutotileSet>> m_autotilesets;
 
@@ -136,6 +157,15 @@ private:
   std::string m_name;
   bool m_corner;
 
+  /** First autotile matching each mask, for solid and for empty centers.
+      Same result as scanning m_autotiles in order, see get_autotile(). */
+  std::array<const Autotile*, 256> m_solid_lookup;
+  std::array<const Autotile*, 256> m_empty_lookup;
+
+  /** First autotile containing each tile ID, indexed from m_members_base */
+  uint32_t m_members_base;
+  std::vector<const Autotile*> m_members;
+
 private:
   AutotileSet(const AutotileSet&) = delete;
   AutotileSet& operator=(const AutotileSet&) = delete;
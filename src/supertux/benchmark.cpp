@@ -0,0 +1,131 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "supertux/benchmark.hpp"
+
+#include <algorithm>
+#include <fmt/format.h>
+#include <ostream>
+
+namespace {
+
+std::string escape_json(const std::string& text)
+{
+  std::string result;
+  result.reserve(text.size());
+  for (const char c : text)
+  {
+    if (c == '"' || c == '\\')
+      result += '\\';
+    result += c;
+  }
+  return result;
+}
+
+double to_ms(int64_t ns)
+{
+  return static_cast<double>(ns) / 1000000.0;
+}
+
+} // namespace
+
+const char*
+Benchmark::get_section_name(Section section)
+{
+  switch (section)
+  {
+    case UPDATE: return "update";
+    case COLLISION: return "collision";
+    case SCRIPTS: return "scripts";
+    case DRAW: return "draw";
+    default: return "unknown";
+  }
+}
+
+Benchmark::Benchmark(const std::string& level, const std::string& replay) :
+  m_level(level),
+  m_replay(replay),
+  m_video(),
+  m_render_thread(false),
+  m_sections(),
+  m_frames(0),
+  m_start_time(std::chrono::steady_clock::now())
+{
+}
+
+void
+Benchmark::add(Section section, std::chrono::steady_clock::duration duration)
+{
+  const int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+  SectionStats& stats = m_sections[section];
+  stats.total_ns += ns;
+  stats.frame_ns += ns;
+  stats.max_ns = std::max(stats.max_ns, ns);
+  ++stats.calls;
+}
+
+void
+Benchmark::finish_frame()
+{
+  for (auto& stats : m_sections)
+  {
+    stats.max_frame_ns = std::max(stats.max_frame_ns, stats.frame_ns);
+    stats.frame_ns = 0;
+  }
+  ++m_frames;
+}
+
+void
+Benchmark::set_video(const std::string& video, bool render_thread)
+{
+  m_video = video;
+  m_render_thread = render_thread;
+}
+
+void
+Benchmark::write_json(std::ostream& out) const
+{
+  const int64_t wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - m_start_time).count();
+  const int frames = std::max(m_frames, 1);
+
+  out << "{\n"
+      << fmt::format("  \"level\": \"{}\",\n", escape_json(m_level))
+      << fmt::format("  \"replay\": \"{}\",\n", escape_json(m_replay))
+      << fmt::format("  \"video\": \"{}\",\n", escape_json(m_video))
+      << fmt::format("  \"render_thread\": {},\n", m_render_thread)
+      << fmt::format("  \"frames\": {},\n", m_frames)
+      << fmt::format("  \"wall_ms\": {:.3f},\n", to_ms(wall_ns))
+      << "  \"sections\": {\n";
+
+  for (int i = 0; i < SECTION_COUNT; ++i)
+  {
+    const SectionStats& stats = m_sections[i];
+    out << fmt::format("    \"{}\": {{ \"total_ms\": {:.3f}, \"avg_frame_ms\": {:.4f}, "
+                       "\"max_frame_ms\": {:.4f}, \"max_call_ms\": {:.4f}, \"calls\": {} }}{}\n",
+                       get_section_name(static_cast<Section>(i)),
+                       to_ms(stats.total_ns),
+                       to_ms(stats.total_ns) / frames,
+                       to_ms(stats.max_frame_ns),
+                       to_ms(stats.max_ns),
+                       stats.calls,
+                       i + 1 < SECTION_COUNT ? "," : "");
+  }
+
+  out << "  }\n"
+      << "}" << std::endl;
+}
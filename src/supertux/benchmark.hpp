@@ -0,0 +1,112 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <iosfwd>
+#include <stdint.h>
+#include <string>
+
+#include "util/currenton.hpp"
+
+/**
+ * Collects per-subsystem timings while running a level headless with
+ * --benchmark. Sections may nest (scripts run inside the update section),
+ * so every section reports inclusive time.
+ */
+class Benchmark final : public Currenton<Benchmark>
+{
+public:
+  enum Section
+  {
+    UPDATE,
+    COLLISION,
+    SCRIPTS,
+    DRAW,
+    SECTION_COUNT
+  };
+
+  /** Times the enclosing scope, does nothing unless a benchmark is running */
+  class Scope final
+  {
+  public:
+    Scope(Section section) :
+      m_benchmark(Benchmark::current()),
+      m_section(section),
+      m_start()
+    {
+      if (m_benchmark)
+        m_start = std::chrono::steady_clock::now();
+    }
+
+    ~Scope()
+    {
+      if (m_benchmark)
+        m_benchmark->add(m_section, std::chrono::steady_clock::now() - m_start);
+    }
+
+  private:
+    Benchmark* m_benchmark;
+    Section m_section;
+    std::chrono::steady_clock::time_point m_start;
+
+  private:
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+private:
+  struct SectionStats
+  {
+    int64_t total_ns = 0;
+    int64_t max_ns = 0;
+    int64_t frame_ns = 0;
+    int64_t max_frame_ns = 0;
+    int calls = 0;
+  };
+
+public:
+  static const char* get_section_name(Section section);
+
+public:
+  Benchmark(const std::string& level, const std::string& replay);
+
+  void add(Section section, std::chrono::steady_clock::duration duration);
+
+  /** Marks the end of a logical step, used for per-frame maxima */
+  void finish_frame();
+
+  /** Records the video system the frames were rendered with, so that
+      runs with and without --render-thread can be told apart */
+  void set_video(const std::string& video, bool render_thread);
+
+  void write_json(std::ostream& out) const;
+
+private:
+  std::string m_level;
+  std::string m_replay;
+  std::string m_video;
+  bool m_render_thread;
+  std::array<SectionStats, SECTION_COUNT> m_sections;
+  int m_frames;
+  std::chrono::steady_clock::time_point m_start_time;
+
+private:
+  Benchmark(const Benchmark&) = delete;
+  Benchmark& operator=(const Benchmark&) = delete;
+};
@@ -37,6 +37,7 @@ CommandLineArguments::CommandLineArguments() :
   aspect_size(),
   use_fullscreen(),
   video(),
+  render_thread(),
   show_fps(),
   show_player_pos(),
   sound_enabled(),
@@ -51,6 +52,12 @@ CommandLineArguments::CommandLineArguments() :
   repository_url(),
   editor(),
   resave(),
+  record_replay(),
+  replay(),
+  benchmark(),
+  benchmark_frames(),
+  record_frames(),
+  record_interval(),
   log_tinygettext(false)
 {
 }
@@ -107,6 +114,8 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("  -a, --aspect WIDTH:HEIGHT    Run SuperTux with given aspect ratio") << "\n"
     << _("  -d, --default                Reset video settings to default values") << "\n"
     << _("  --renderer RENDERER          Use sdl, opengl, or auto to render") << "\n"
+    << _("  --render-thread              Render frames on a separate thread (OpenGL only)") << "\n"
+    << _("  --no-render-thread           Render frames on the main thread") << "\n"
     << "\n"
     << _("Audio Options:") << "\n"
     << _("  --disable-sound              Disable sound effects") << "\n"
@@ -124,6 +133,14 @@ CommandLineArguments::print_help(const char* arg0) const
     << _("  --spawn-pos X,Y              Where in the level to spawn Tux. Only used if level is specified.") << "\n"
     << _("  --sector SECTOR              Spawn Tux in SECTOR\n") << "\n"
     << _("  --spawnpoint SPAWNPOINT      Spawn Tux at SPAWNPOINT\n") << "\n"
+    << _("  --record-replay FILE         Record the input of each game step to FILE") << "\n"
+    << _("  --record-frames DIR          Save the rendered frames as PNG files to DIR in the user directory") << "\n"
+    << _("  --record-interval N          Only save every Nth frame with --record-frames") << "\n"
+    << "\n"
+    << _("Benchmark Options:") << "\n"
+    << _("  --benchmark LEVELFILE        Run LEVELFILE headless and print timings as JSON") << "\n"
+    << _("  --replay FILE                Feed the input recorded in FILE into the benchmark") << "\n"
+    << _("  --frames N                   Number of game steps to run in the benchmark") << "\n"
     << "\n"
     << _("Directory Options:") << "\n"
     << _("  --datadir DIR                Set the directory for the game's data files") << "\n"
@@ -285,6 +302,14 @@ CommandLineArguments::parse_args(int argc, char** argv)
         video = VideoSystem::get_video_system(argv[i]);
       }
     }
+    else if (arg == "--render-thread")
+    {
+      render_thread = true;
+    }
+    else if (arg == "--no-render-thread")
+    {
+      render_thread = false;
+    }
     else if (arg == "--show-fps")
     {
       show_fps = true;
@@ -375,6 +400,49 @@ CommandLineArguments::parse_args(int argc, char** argv)
     {
       resave = true;
     }
+    else if (arg == "--record-replay")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("--record-replay FILE needs an argument");
+      record_replay = argv[i];
+    }
+    else if (arg == "--benchmark")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("--benchmark LEVELFILE needs an argument");
+      benchmark = true;
+      filenames.push_back(argv[i]);
+    }
+    else if (arg == "--replay")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("--replay FILE needs an argument");
+      replay = argv[i];
+    }
+    else if (arg == "--frames")
+    {
+      int frames = 0;
+      if (++i >= argc)
+        throw std::runtime_error("--frames N needs an argument");
+      if (sscanf(argv[i], "%9d", &frames) != 1 || frames <= 0)
+        throw std::runtime_error("Invalid frame count, should be a positive number");
+      benchmark_frames = frames;
+    }
+    else if (arg == "--record-frames")
+    {
+      if (++i >= argc)
+        throw std::runtime_error("--record-frames DIR needs an argument");
+      record_frames = argv[i];
+    }
+    else if (arg == "--record-interval")
+    {
+      int interval = 0;
+      if (++i >= argc)
+        throw std::runtime_error("--record-interval N needs an argument");
+      if (sscanf(argv[i], "%9d", &interval) != 1 || interval <= 0)
+        throw std::runtime_error("Invalid frame interval, should be a positive number");
+      record_interval = interval;
+    }
     else if (arg[0] != '-')
     {
       filenames.push_back(arg);
@@ -389,6 +457,18 @@ CommandLineArguments::parse_args(int argc, char** argv)
   if (filenames.size() > 1 && !(resave && *resave)) {
     throw std::runtime_error("Only one filename allowed for the given options");
   }
+
+  if ((replay || benchmark_frames) && !benchmark) {
+    throw std::runtime_error("--replay and --frames can only be used together with --benchmark");
+  }
+
+  if (record_replay && (filenames.empty() || benchmark || editor)) {
+    throw std::runtime_error("--record-replay needs a level file to play");
+  }
+
+  if (record_interval && !record_frames) {
+    throw std::runtime_error("--record-interval can only be used together with --record-frames");
+  }
 }
 
 void
@@ -402,6 +482,7 @@ CommandLineArguments::merge_into(Config& config)
   merge_option(aspect_size)
   merge_option(use_fullscreen)
   merge_option(video)
+  merge_option(render_thread)
   merge_option(show_fps)
   merge_option(show_player_pos)
   merge_option(sound_enabled)
@@ -56,6 +56,7 @@ public:
 
   std::optional<bool> use_fullscreen;
   std::optional<VideoSystem::Enum> video;
+  std::optional<bool> render_thread;
   // std::optional<bool> try_vsync;
   std::optional<bool> show_fps;
   std::optional<bool> show_player_pos;
@@ -78,6 +79,13 @@ public:
 
   std::optional<bool> editor;
   std::optional<bool> resave;
+
+  std::optional<std::string> record_replay;
+  std::optional<std::string> replay;
+  std::optional<bool> benchmark;
+  std::optional<int> benchmark_frames;
+  std::optional<std::string> record_frames;
+  std::optional<int> record_interval;
   bool log_tinygettext;
 
   // std::optional<std::string> locale;
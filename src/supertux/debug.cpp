@@ -18,6 +18,7 @@
 
 #include "supertux/resources.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 
 Debug g_debug;
 
@@ -28,7 +29,8 @@ Debug::Debug() :
   show_toolbox_tile_ids(false),
   hide_player_hud(false),
   m_use_bitmap_fonts(false),
-  m_game_speed_multiplier(1.0f)
+  m_game_speed_multiplier(1.0f),
+  m_show_profiler(false)
 {
 }
 
@@ -45,3 +47,15 @@ Debug::set_game_speed_multiplier(float v)
   m_game_speed_multiplier = v;
   log_info << m_game_speed_multiplier << std::endl;
 }
+
+void
+Debug::set_show_profiler(bool value)
+{
+#ifdef ENABLE_PROFILER
+  m_show_profiler = value;
+  Profiler::set_enabled(value);
+#else
+  if (value)
+    log_warning << "SuperTux was built without ENABLE_PROFILER" << std::endl;
+#endif
+}
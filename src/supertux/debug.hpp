@@ -27,6 +27,10 @@ public:
   void set_game_speed_multiplier(float v);
   inline float get_game_speed_multiplier() const { return m_game_speed_multiplier; }
 
+  /** Shows the profiler overlay, which also starts recording profiler zones */
+  void set_show_profiler(bool value);
+  inline bool get_show_profiler() const { return m_show_profiler; }
+
 public:
   /** Show collision rectangles of moving objects */
   bool show_collision_rects;
@@ -51,6 +55,8 @@ private:
   /** Speed up or slow down the game */
   float m_game_speed_multiplier;
 
+  bool m_show_profiler;
+
 private:
   Debug(const Debug&) = delete;
   Debug& operator=(const Debug&) = delete;
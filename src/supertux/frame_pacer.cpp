@@ -0,0 +1,99 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "supertux/frame_pacer.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace {
+
+/** Length of the individual sleeps */
+const std::chrono::microseconds SLEEP_SLICE(1000);
+
+/** Upper bound for the time spent spinning, on systems with a coarse
+    timer it's better to oversleep than to burn a core */
+const std::chrono::microseconds MAX_SPIN(2000);
+
+} // namespace
+
+FramePacer::FramePacer() :
+  m_target_fps(0.0f),
+  m_frame_duration(),
+  m_next_frame(Clock::now()),
+  m_sleep_overshoot(std::chrono::microseconds(250))
+{
+}
+
+void
+FramePacer::set_target_fps(float fps, Clock::time_point now)
+{
+  m_target_fps = std::max(fps, 0.0f);
+  m_frame_duration = m_target_fps > 0.0f ?
+    std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.0f / m_target_fps)) :
+    Clock::duration();
+  m_next_frame = now;
+}
+
+void
+FramePacer::wait_for_next_frame()
+{
+  if (m_target_fps <= 0.0f)
+    return;
+
+  sleep_until(next_frame(Clock::now()));
+}
+
+FramePacer::Clock::time_point
+FramePacer::next_frame(Clock::time_point now)
+{
+  if (m_target_fps <= 0.0f)
+    return now;
+
+  m_next_frame += m_frame_duration;
+
+  // After a slow frame, don't try to catch up by rushing through the
+  // following ones.
+  if (m_next_frame < now)
+    m_next_frame = now;
+
+  return m_next_frame;
+}
+
+void
+FramePacer::sleep_until(Clock::time_point deadline)
+{
+#ifdef __EMSCRIPTEN__
+  std::this_thread::sleep_until(deadline);
+#else
+  while (deadline - Clock::now() > SLEEP_SLICE + m_sleep_overshoot)
+  {
+    const auto start = Clock::now();
+    std::this_thread::sleep_for(SLEEP_SLICE);
+    const auto overshoot = Clock::now() - start - SLEEP_SLICE;
+
+    // Follow longer overshoots right away and shorter ones slowly.
+    if (overshoot > m_sleep_overshoot)
+      m_sleep_overshoot = std::min<Clock::duration>(overshoot, MAX_SPIN);
+    else
+      m_sleep_overshoot = (m_sleep_overshoot * 7 + overshoot) / 8;
+  }
+
+  while (Clock::now() < deadline)
+    std::this_thread::yield();
+#endif
+}
@@ -0,0 +1,62 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <chrono>
+
+/** Paces frames against std::chrono::steady_clock deadlines. Sleeping
+    has a granularity of about a millisecond and the OS tends to
+    oversleep, so only the bulk of each wait is slept, and the last part
+    of it is spent spinning. */
+class FramePacer final
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+public:
+  FramePacer();
+
+  /** Caps the frame rate at the given value, 0 disables the cap. The
+      first frame is due at @c now. */
+  void set_target_fps(float fps, Clock::time_point now = Clock::now());
+  inline float get_target_fps() const { return m_target_fps; }
+
+  /** Waits until the next frame is due, if the frame rate is capped */
+  void wait_for_next_frame();
+
+  /** Advances to the next frame and returns when it is due, given the
+      current time. That's @c now if the frame rate isn't capped, or if
+      the previous frame took too long. */
+  Clock::time_point next_frame(Clock::time_point now);
+
+  /** Waits until the given point in time, never returns before it */
+  void sleep_until(Clock::time_point deadline);
+
+  /** Current estimate of how much the OS oversleeps */
+  inline Clock::duration get_sleep_overshoot() const { return m_sleep_overshoot; }
+
+private:
+  float m_target_fps;
+  Clock::duration m_frame_duration;
+  Clock::time_point m_next_frame;
+  Clock::duration m_sleep_overshoot;
+
+private:
+  FramePacer(const FramePacer&) = delete;
+  FramePacer& operator=(const FramePacer&) = delete;
+};
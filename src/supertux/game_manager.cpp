@@ -47,14 +47,16 @@ GameManager::save()
 
 void
 GameManager::start_level(const World& world, const std::string& level_filename,
-                         const std::optional<std::pair<std::string, Vector>>& start_pos)
+                         const std::optional<std::pair<std::string, Vector>>& start_pos,
+                         std::shared_ptr<const ReaderDocument> level_document)
 {
   m_savegame = Savegame::from_current_profile(world.get_basename());
 
   auto screen = std::make_unique<LevelsetScreen>(world.get_basedir(),
                                                  level_filename,
                                                  *m_savegame,
-                                                 start_pos);
+                                                 start_pos,
+                                                 std::move(level_document));
   ScreenManager::current()->push_screen(std::move(screen));
 
   if (!Editor::current())
@@ -24,6 +24,7 @@
 
 #include "math/vector.hpp"
 
+class ReaderDocument;
 class Savegame;
 class World;
 
@@ -39,7 +40,8 @@ public:
   bool start_worldmap(const World& world, const std::string& worldmap_filename,
                       const std::optional<std::pair<std::string, Vector>>& start_pos);
   void start_level(const World& world, const std::string& level_filename,
-                   const std::optional<std::pair<std::string, Vector>>& start_pos = std::nullopt);
+                   const std::optional<std::pair<std::string, Vector>>& start_pos = std::nullopt,
+                   std::shared_ptr<const ReaderDocument> level_document = {});
 
 private:
   std::unique_ptr<Savegame> m_savegame;
@@ -189,6 +189,10 @@ public:
   /** returns true if the object is not scheduled to be removed yet */
   inline bool is_valid() const { return !m_scheduled_for_removal; }
 
+  /** returns true if the object is outside of the active region of its
+      sector and is currently neither updated nor drawn */
+  inline bool is_sleeping() const { return m_sleeping; }
+
   /** registers a remove listener which will be called if the object
       gets removed/destroyed */
   void add_remove_listener(ObjectRemoveListener* listener);
@@ -307,6 +311,9 @@ private:
   /** this flag indicates if the object should be removed at the end of the frame */
   bool m_scheduled_for_removal;
 
+  /** Set by the GameObjectManager, see is_sleeping() */
+  bool m_sleeping;
+
   /** The object's settings at the time of the last state save.
       Used to check for changes that may have occured. */
   std::optional<ObjectSettings> m_last_state;
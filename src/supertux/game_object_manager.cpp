@@ -46,6 +46,8 @@ GameObjectManager::GameObjectManager(bool undo_tracking) :
   m_pending_change_stack(),
   m_last_saved_change(),
   m_gameobjects(),
+  m_awake_objects(),
+  m_awake_objects_dirty(false),
   m_gameobjects_new(),
   m_moved_object_uids(),
   m_solid_tilemaps(),
@@ -215,12 +217,25 @@ GameObjectManager::clear_objects()
     before_object_remove(*obj);
   }
   m_gameobjects.clear();
+  m_awake_objects.clear();
+  m_awake_objects_dirty = false;
 }
 
 void
 GameObjectManager::update(float dt_sec)
 {
-  for (const auto& object : m_gameobjects)
+  if (m_awake_objects_dirty)
+  {
+    m_awake_objects.clear();
+    for (const auto& object : m_gameobjects)
+    {
+      if (!object->is_sleeping())
+        m_awake_objects.push_back(object.get());
+    }
+    m_awake_objects_dirty = false;
+  }
+
+  for (auto* object : m_awake_objects)
   {
     if (!object->is_valid())
       continue;
@@ -229,6 +244,16 @@ GameObjectManager::update(float dt_sec)
   }
 }
 
+void
+GameObjectManager::set_object_sleeping(GameObject& object, bool sleeping)
+{
+  if (object.m_sleeping == sleeping)
+    return;
+
+  object.m_sleeping = sleeping;
+  m_awake_objects_dirty = true;
+}
+
 void
 GameObjectManager::draw(DrawingContext& context)
 {
@@ -246,7 +271,7 @@ GameObjectManager::draw(DrawingContext& context)
 
   for (const auto& object : m_gameobjects)
   {
-    if (!object->is_valid())
+    if (!object->is_valid() || object->is_sleeping())
       continue;
 
     object->draw(context);
@@ -256,6 +281,8 @@ GameObjectManager::draw(DrawingContext& context)
 void
 GameObjectManager::flush_game_objects()
 {
+  const size_t old_size = m_gameobjects.size();
+
   { // Clean up marked objects.
     m_gameobjects.erase(
       std::remove_if(m_gameobjects.begin(), m_gameobjects.end(),
@@ -288,10 +315,14 @@ GameObjectManager::flush_game_objects()
             m_gameobjects.insert(m_gameobjects.begin(), std::move(object));
           else
             m_gameobjects.push_back(std::move(object));
+          m_awake_objects_dirty = true;
         }
       }
     }
   }
+
+  if (m_gameobjects.size() != old_size)
+    m_awake_objects_dirty = true;
   update_tilemaps();
 
   // A resolve request may depend on an object being added.
@@ -352,9 +383,11 @@ GameObjectManager::move_object(const UID& uid, GameObjectManager& other)
 
   this_before_object_remove(*obj);
   before_object_remove(*obj);
+  obj->m_sleeping = false;
 
   other.add_object(std::move(obj));
   m_gameobjects.erase(it);
+  m_awake_objects_dirty = true;
 
   other.flush_game_objects();
 }
@@ -298,6 +298,10 @@ protected:
 
   void update_tilemaps();
 
+  /** Sleeping objects are skipped by update() and draw(), until woken
+      up again by passing false */
+  void set_object_sleeping(GameObject& object, bool sleeping);
+
   void process_resolve_requests();
 
   /** Same as process_resolve_requests(), but those it can't find will be kept in the buffer */
@@ -351,6 +355,12 @@ private:
 
   std::vector<std::unique_ptr<GameObject>> m_gameobjects;
 
+  /** Objects of m_gameobjects that are not sleeping, in the same order.
+      Rebuilt before the next update() whenever m_gameobjects changes or
+      an object falls asleep or wakes up. */
+  std::vector<GameObject*> m_awake_objects;
+  bool m_awake_objects_dirty;
+
   /** container for newly created objects, they'll be added in flush_game_objects() */
   std::vector<std::unique_ptr<GameObject>> m_gameobjects_new;
 
@@ -17,6 +17,7 @@
 #include "supertux/game_session.hpp"
 
 #include <cfloat>
+#include <chrono>
 #include <fmt/format.h>
 #include <stdexcept>
 
@@ -48,6 +49,7 @@
 #include "supertux/sector.hpp"
 #include "supertux/shrinkfade.hpp"
 #include "util/file_system.hpp"
+#include "util/profiler.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
 #include "video/surface.hpp"
@@ -70,6 +72,7 @@ GameSession::GameSession(const std::string& levelfile_, Savegame& savegame, Stat
   m_game_pause(false),
   m_speed_before_pause(ScreenManager::current()->get_speed()),
   m_levelfile(levelfile_),
+  m_level_document(),
   m_spawnpoints(),
   m_activated_checkpoint(),
   m_newsector(),
@@ -194,7 +197,20 @@ GameSession::restart_level(bool after_death, bool preserve_music)
   }
 
   try {
-    m_level = LevelParser::from_file(m_levelfile, false, false);
+    if (m_level_document)
+    {
+      const bool first_load = !m_level;
+      const auto start = std::chrono::steady_clock::now();
+      m_level = LevelParser::from_document(*m_level_document, m_levelfile, false, false);
+      if (first_load)
+        log_info << "Level snapshot loaded in "
+                 << std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count()
+                 << " ms" << std::endl;
+    }
+    else
+    {
+      m_level = LevelParser::from_file(m_levelfile, false, false);
+    }
 
     /* Determine the spawnpoint to spawn/respawn Tux to. */
     const GameSession::SpawnPoint* spawnpoint = nullptr;
@@ -516,6 +532,8 @@ GameSession::leave()
 void
 GameSession::update(float dt_sec, const Controller& controller)
 {
+  PROFILE_ZONE("GameSession::update");
+
   // Set active flag.
   if (!m_active)
   {
@@ -41,6 +41,7 @@ class DrawingContext;
 class EndSequence;
 class Level;
 class Player;
+class ReaderDocument;
 class Sector;
 class Statistics;
 class Savegame;
@@ -131,6 +132,13 @@ public:
   inline bool has_active_sequence() const { return m_end_sequence; }
   void restart_level(bool after_death = false, bool preserve_music = false);
 
+  /** Don't wait for input on the LevelIntro screen, used for replays */
+  inline void skip_levelintro() { m_levelintro_shown = true; }
+
+  /** Load the level from the given document instead of the level file,
+      used to test levels from the editor without a round-trip to disk */
+  inline void set_level_document(std::shared_ptr<const ReaderDocument> doc) { m_level_document = std::move(doc); }
+
   void toggle_pause();
   void abort_level();
   bool is_active() const;
@@ -169,6 +177,7 @@ private:
   float m_speed_before_pause;
 
   std::string m_levelfile;
+  std::shared_ptr<const ReaderDocument> m_level_document;
 
   // Spawnpoints
   std::vector<SpawnPoint> m_spawnpoints;
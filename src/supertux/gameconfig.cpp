@@ -54,6 +54,9 @@ Config::Config() :
   video(VideoSystem::VIDEO_SDL),
   vsync(1),
   frame_prediction(false),
+  render_thread(false),
+  texture_cache(true),
+  target_fps(0),
   show_fps(false),
   show_player_pos(false),
   show_controller(false),
@@ -74,6 +77,7 @@ Config::Config() :
   mobile_controls(SDL_GetNumTouchDevices() > 0),
   m_mobile_controls_scale(1),
   addons(),
+  addon_hashes(),
   developer_mode(false),
   christmas_mode(false),
   transitions_enabled(true),
@@ -147,6 +151,9 @@ Config::load()
 
   config_mapping.get("flash_intensity", flash_intensity);
   config_mapping.get("frame_prediction", frame_prediction);
+  config_mapping.get("render_thread", render_thread);
+  config_mapping.get("texture_cache", texture_cache);
+  config_mapping.get("target_fps", target_fps);
   config_mapping.get("show_fps", show_fps);
   config_mapping.get("show_player_pos", show_player_pos);
   config_mapping.get("show_controller", show_controller);
@@ -350,6 +357,28 @@ Config::load()
           addons.push_back({id, enabled});
         }
       }
+      else if (addon_node.get_name() == "hash")
+      {
+        auto hash = addon_node.get_mapping();
+
+        // Sizes and timestamps don't fit into the reader's int, so they
+        // are stored as strings.
+        std::string file, size, mtime, md5;
+        if (hash.get("file", file) &&
+            hash.get("size", size) &&
+            hash.get("mtime", mtime) &&
+            hash.get("md5", md5))
+        {
+          try
+          {
+            addon_hashes.push_back({file, std::stoll(size), std::stoll(mtime), md5});
+          }
+          catch (const std::exception&)
+          {
+            log_warning << "Invalid add-on hash entry for " << file << " in config file" << std::endl;
+          }
+        }
+      }
       else
       {
         log_warning << "Unknown token in config file: " << addon_node.get_name() << std::endl;
@@ -373,6 +402,9 @@ Config::save()
   writer.write("profile", profile);
 
   writer.write("frame_prediction", frame_prediction);
+  writer.write("render_thread", render_thread);
+  writer.write("texture_cache", texture_cache);
+  writer.write("target_fps", target_fps);
   writer.write("show_fps", show_fps);
   writer.write("show_player_pos", show_player_pos);
   writer.write("show_controller", show_controller);
@@ -498,6 +530,15 @@ Config::save()
     writer.write("enabled", addon.enabled);
     writer.end_list("addon");
   }
+  for (const auto& hash : addon_hashes)
+  {
+    writer.start_list("hash");
+    writer.write("file", hash.file);
+    writer.write("size", std::to_string(hash.size));
+    writer.write("mtime", std::to_string(hash.mtime));
+    writer.write("md5", hash.md5);
+    writer.end_list("hash");
+  }
   writer.end_list("addons");
 
   writer.start_list("editor");
@@ -69,6 +69,16 @@ public:
   VideoSystem::Enum video;
   int vsync;
   bool frame_prediction;
+
+  /** Render frames on a separate thread while the next one is recorded */
+  bool render_thread;
+
+  /** Keep decoded tileset images in the user directory, so that later
+      runs don't have to decode them again */
+  bool texture_cache;
+
+  /** Frame rate cap, independent of the logical frame rate, 0 is uncapped */
+  int target_fps;
   bool show_fps;
   bool show_player_pos;
   bool show_controller;
@@ -112,6 +122,17 @@ public:
   };
   std::vector<Addon> addons;
 
+  /** MD5 of an installed add-on archive, valid for as long as the
+      archive keeps its size and modification time */
+  struct AddonHash
+  {
+    std::string file;
+    int64_t size;
+    int64_t mtime;
+    std::string md5;
+  };
+  std::vector<AddonHash> addon_hashes;
+
   bool developer_mode;
   bool christmas_mode;
   bool transitions_enabled;
@@ -118,31 +118,35 @@ Level::save(std::ostream& stream)
   save(writer);
 }
 
+void
+Level::create_directory(const std::string& filepath)
+{
+  std::string dirname = FileSystem::dirname(filepath);
+  if (!PHYSFS_exists(dirname.c_str()))
+  {
+    if (!PHYSFS_mkdir(dirname.c_str()))
+    {
+      std::ostringstream msg;
+      msg << "Couldn't create directory for level '"
+          << dirname << "': " <<physfsutil::get_last_error();
+      throw std::runtime_error(msg.str());
+    }
+  }
+
+  if (!physfsutil::is_directory(dirname))
+  {
+    std::ostringstream msg;
+    msg << "Level path '" << dirname << "' is not a directory";
+    throw std::runtime_error(msg.str());
+  }
+}
+
 void
 Level::save(const std::string& filepath, bool retry)
 {
   //FIXME: It tests for directory in supertux/data, but saves into .supertux2.
   try {
-    { // make sure the level directory exists
-      std::string dirname = FileSystem::dirname(filepath);
-      if (!PHYSFS_exists(dirname.c_str()))
-      {
-        if (!PHYSFS_mkdir(dirname.c_str()))
-        {
-          std::ostringstream msg;
-          msg << "Couldn't create directory for level '"
-              << dirname << "': " <<physfsutil::get_last_error();
-          throw std::runtime_error(msg.str());
-        }
-      }
-
-      if (!physfsutil::is_directory(dirname))
-      {
-        std::ostringstream msg;
-        msg << "Level path '" << dirname << "' is not a directory";
-        throw std::runtime_error(msg.str());
-      }
-    }
+    create_directory(filepath);
 
     Writer writer(filepath);
     save(writer);
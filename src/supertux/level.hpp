@@ -37,6 +37,11 @@ public:
 private:
   static Level* s_current;
 
+public:
+  /** Creates the directory of the given level file, if it doesn't
+      exist yet. Throws if it can't be created or isn't a directory. */
+  static void create_directory(const std::string& filename);
+
 public:
   explicit Level(bool m_is_worldmap);
   ~Level();
@@ -72,6 +72,18 @@ LevelParser::from_file(const std::string& filename, bool worldmap, bool editable
   return level;
 }
 
+std::unique_ptr<Level>
+LevelParser::from_document(const ReaderDocument& doc, const std::string& filename, bool worldmap, bool editable)
+{
+  auto level = std::make_unique<Level>(worldmap);
+  level->m_filename = filename;
+  register_translation_directory(filename);
+
+  LevelParser parser(*level, worldmap, editable);
+  parser.load(doc);
+  return level;
+}
+
 std::unique_ptr<Level>
 LevelParser::from_nothing(const std::string& basedir)
 {
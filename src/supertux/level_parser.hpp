@@ -28,6 +28,11 @@ class LevelParser final
 public:
   static std::unique_ptr<Level> from_stream(std::istream& stream, const std::string& context, bool worldmap, bool editable);
   static std::unique_ptr<Level> from_file(const std::string& filename, bool worldmap, bool editable);
+
+  /** Creates a level from an already parsed document, as if it had been
+      loaded from the given file */
+  static std::unique_ptr<Level> from_document(const ReaderDocument& doc, const std::string& filename,
+                                              bool worldmap, bool editable);
   static std::unique_ptr<Level> from_nothing(const std::string& basedir);
   static std::unique_ptr<Level> from_nothing_worldmap(const std::string& basedir, const std::string& name);
 
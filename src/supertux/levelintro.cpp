@@ -171,8 +171,16 @@ LevelIntro::draw(Compositor& compositor)
 
   if (m_best_level_statistics)
   {
+    static const TranslatedString s_header(N_("Best Level Statistics"),
+                                           [](const std::string& header) { return "- " + header + " -"; });
+    static const TranslatedString s_coins(N_("Coins"));
+    static const TranslatedString s_badguys(N_("Badguys killed"));
+    static const TranslatedString s_secrets(N_("Secrets"));
+    static const TranslatedString s_best_time(N_("Best time"));
+    static const TranslatedString s_target_time(N_("Level target time"));
+
     context.color().draw_center_text(Resources::normal_font,
-                                     std::string("- ") + _("Best Level Statistics") + std::string(" -"),
+                                     s_header,
                                      Vector(0, static_cast<float>(py)),
                                      LAYER_FOREGROUND1, s_stat_hdr_color);
 
@@ -181,29 +189,29 @@ LevelIntro::draw(Compositor& compositor)
     const Statistics::Preferences& preferences = m_level.m_stats.get_preferences();
     if (preferences.enable_coins)
     {
-      draw_stats_line(context, py, _("Coins"),
+      draw_stats_line(context, py, s_coins,
                       Statistics::coins_to_string(m_best_level_statistics->get_coins(), stats.m_total_coins),
                       m_best_level_statistics->get_coins() >= stats.m_total_coins);
     }
     if (preferences.enable_badguys)
     {
-      draw_stats_line(context, py, _("Badguys killed"),
+      draw_stats_line(context, py, s_badguys,
                       Statistics::frags_to_string(m_best_level_statistics->get_badguys(), stats.m_total_badguys),
                       m_best_level_statistics->get_badguys() >= stats.m_total_badguys);
     }
     if (preferences.enable_secrets)
     {
-      draw_stats_line(context, py, _("Secrets"),
+      draw_stats_line(context, py, s_secrets,
                       Statistics::secrets_to_string(m_best_level_statistics->get_secrets(), stats.m_total_secrets),
                       m_best_level_statistics->get_secrets() >= stats.m_total_secrets);
     }
 
     bool targetTimeBeaten = m_level.m_target_time == 0.0f || (m_best_level_statistics->get_time() != 0.0f && m_best_level_statistics->get_time() < m_level.m_target_time);
-    draw_stats_line(context, py, _("Best time"),
+    draw_stats_line(context, py, s_best_time,
                     Statistics::time_to_string(m_best_level_statistics->get_time()), targetTimeBeaten);
 
     if (m_level.m_target_time != 0.0f) {
-      draw_stats_line(context, py, _("Level target time"),
+      draw_stats_line(context, py, s_target_time,
                       Statistics::time_to_string(m_level.m_target_time), targetTimeBeaten);
     }
   }
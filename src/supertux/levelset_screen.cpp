@@ -29,13 +29,15 @@
 
 LevelsetScreen::LevelsetScreen(const std::string& basedir, const std::string& level_filename,
                                Savegame& savegame,
-                               const std::optional<std::pair<std::string, Vector>>& start_pos) :
+                               const std::optional<std::pair<std::string, Vector>>& start_pos,
+                               std::shared_ptr<const ReaderDocument> level_document) :
   m_basedir(basedir),
   m_level_filename(level_filename),
   m_savegame(savegame),
   m_level_started(false),
   m_solved(false),
-  m_start_pos(start_pos)
+  m_start_pos(start_pos),
+  m_level_document(std::move(level_document))
 {
   Levelset levelset(basedir);
   for (int i = 0; i < levelset.get_num_levels(); ++i)
@@ -89,6 +91,9 @@ LevelsetScreen::setup()
       if (m_start_pos) {
         screen->set_start_pos(m_start_pos->first, m_start_pos->second);
       }
+      if (m_level_document) {
+        screen->set_level_document(m_level_document);
+      }
 
       try
       {
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -23,6 +24,7 @@
 #include "supertux/screen.hpp"
 #include "util/currenton.hpp"
 
+class ReaderDocument;
 class Savegame;
 
 class LevelsetScreen final : public Screen,
@@ -37,7 +39,8 @@ private:
 
 public:
   LevelsetScreen(const std::string& basedir, const std::string& level_filename, Savegame& savegame,
-                 const std::optional<std::pair<std::string, Vector>>& start_pos);
+                 const std::optional<std::pair<std::string, Vector>>& start_pos,
+                 std::shared_ptr<const ReaderDocument> level_document = {});
 
   virtual void draw(Compositor& compositor) override;
   virtual void update(float dt_sec, const Controller& controller) override;
@@ -51,6 +54,7 @@ public:
 
 private:
   std::optional<std::pair<std::string, Vector>> m_start_pos;
+  std::shared_ptr<const ReaderDocument> m_level_document;
 
   LevelsetScreen(const LevelsetScreen&) = delete;
   LevelsetScreen& operator=(const LevelsetScreen&) = delete;
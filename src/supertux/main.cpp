@@ -18,8 +18,10 @@
 
 #include <config.h>
 #include <version.h>
+#include <ctime>
 #include <filesystem>
 #include <fstream>
+#include <iostream>
 
 #include <SDL_image.h>
 #include <SDL_ttf.h>
@@ -37,6 +39,7 @@ extern "C" {
 #include "addon/addon_manager.hpp"
 #include "addon/downloader.hpp"
 #include "audio/sound_manager.hpp"
+#include "control/replay.hpp"
 #include "editor/editor.hpp"
 #include "editor/layer_icon.hpp"
 #include "editor/object_info.hpp"
@@ -56,6 +59,7 @@ extern "C" {
 #include "sdk/integration.hpp"
 #include "sprite/sprite_data.hpp"
 #include "sprite/sprite_manager.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/command_line_arguments.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/console.hpp"
@@ -170,6 +174,8 @@ Main::init_tinygettext()
     FL_FreeLocale(&locale);
     g_dictionary_manager->set_language(language);
   }
+
+  invalidate_translations();
 }
 
 PhysfsSubsystem::PhysfsSubsystem(const char* argv0,
@@ -525,7 +531,7 @@ void
 Main::launch_game(const CommandLineArguments& args)
 {
   s_timelog.log("addons");
-  m_addon_manager.reset(new AddonManager("addons", g_config->addons));
+  m_addon_manager.reset(new AddonManager("addons", g_config->addons, g_config->addon_hashes));
 
   /** Add-ons or the user directory may have possibly overriden essential files,
       so re-mount the directories, containing those files. */
@@ -546,7 +552,7 @@ Main::launch_game(const CommandLineArguments& args)
 
 #ifndef EMSCRIPTEN
   auto video = g_config->video;
-  if (args.resave && *args.resave) {
+  if ((args.resave && *args.resave) || (args.benchmark && *args.benchmark)) {
     if (args.video) {
       video = *args.video;
     } else {
@@ -555,6 +561,9 @@ Main::launch_game(const CommandLineArguments& args)
   }
   s_timelog.log("video");
 
+  if (args.record_frames && video == VideoSystem::VIDEO_NULL)
+    log_warning << "The null video system has no pixels to record, choose another one with --renderer" << std::endl;
+
   m_video_system = VideoSystem::create(video);
 #else
   // Force SDL for WASM builds, as OpenGL is reportedly slow on some devices
@@ -566,8 +575,16 @@ Main::launch_game(const CommandLineArguments& args)
 
   s_timelog.log("audio");
   m_sound_manager.reset(new SoundManager());
-  m_sound_manager->enable_sound(g_config->sound_enabled);
-  m_sound_manager->enable_music(g_config->music_enabled);
+  if (args.benchmark && *args.benchmark)
+  {
+    m_sound_manager->enable_sound(false);
+    m_sound_manager->enable_music(false);
+  }
+  else
+  {
+    m_sound_manager->enable_sound(g_config->sound_enabled);
+    m_sound_manager->enable_music(g_config->music_enabled);
+  }
   m_sound_manager->set_sound_volume(g_config->sound_volume);
   m_sound_manager->set_music_volume(g_config->music_volume);
 
@@ -592,6 +609,9 @@ Main::launch_game(const CommandLineArguments& args)
   m_game_manager.reset(new GameManager());
   m_screen_manager.reset(new ScreenManager(*m_video_system, *m_input_manager));
 
+  if (args.record_frames)
+    m_screen_manager->set_frame_recording(*args.record_frames, args.record_interval.value_or(1));
+
   if (!args.filenames.empty())
   {
     for(const auto& start_level : args.filenames)
@@ -630,32 +650,27 @@ Main::launch_game(const CommandLineArguments& args)
       {
         m_screen_manager->push_screen(std::make_unique<worldmap::WorldMap>(filename, *m_savegame));
       }
+      else if (args.benchmark && *args.benchmark)
+      {
+        run_benchmark(filename, args);
+        return;
+      }
       else
       { // launch game
         std::unique_ptr<GameSession> session = std::make_unique<GameSession>(filename, *m_savegame);
+        const ReplayStart start{ args.sector, args.spawnpoint, g_config->tux_spawn_pos };
 
-        gameRandom.seed(g_config->random_seed);
-        graphicsRandom.seed(0);
-
-        if (args.sector || args.spawnpoint)
-        {
-          std::string sectorname = args.sector.value_or(DEFAULT_SECTOR_NAME);
-
-          const auto& spawnpoints = session->get_current_sector().get_objects_by_type<SpawnPointMarker>();
-          std::string default_spawnpoint = (spawnpoints.begin() != spawnpoints.end()) ?
-            "" : spawnpoints.begin()->get_name();
-          std::string spawnpointname = args.spawnpoint.value_or(default_spawnpoint);
-
-          session->set_start_point(sectorname, spawnpointname);
-        }
-
-        if (g_config->tux_spawn_pos)
+        int seed = g_config->random_seed;
+        if (args.record_replay)
         {
-          // FIXME: Specify start pos for multiple players
-          session->get_current_sector().get_players()[0]->set_pos(*g_config->tux_spawn_pos);
+          // A replay is only reproducible with a known seed, so don't let
+          // Random::seed() pick one from the current time.
+          seed = g_config->random_seed > 0 ? g_config->random_seed : static_cast<int>(std::time(nullptr));
+          m_screen_manager->set_replay_writer(std::make_unique<ReplayWriter>(*args.record_replay, filename, seed, start));
+          session->skip_levelintro();
         }
 
-        session->restart_level();
+        start_session(*session, seed, start);
         m_screen_manager->push_screen(std::move(session));
       }
     }
@@ -678,6 +693,62 @@ Main::launch_game(const CommandLineArguments& args)
   m_screen_manager->run();
 }
 
+void
+Main::run_benchmark(const std::string& filename, const CommandLineArguments& args)
+{
+  std::unique_ptr<ReplayReader> replay;
+  if (args.replay)
+  {
+    replay = std::make_unique<ReplayReader>(*args.replay);
+    if (replay->get_level() != filename)
+      log_warning << "Replay was recorded on '" << replay->get_level() << "', not on '" << filename << "'" << std::endl;
+  }
+
+  const int steps = args.benchmark_frames.value_or(replay ? replay->get_total_steps() : 10 * LOGICAL_FPS);
+
+  // Follow the order of launch_game(), so that a recorded replay sees the
+  // same random numbers and starts at the same place.
+  auto session = std::make_unique<GameSession>(filename, *m_savegame);
+  session->skip_levelintro();
+  if (replay)
+    start_session(*session, replay->get_seed(), replay->get_start());
+  else
+    start_session(*session, std::max(g_config->random_seed, 1),
+                  ReplayStart{ args.sector, args.spawnpoint, g_config->tux_spawn_pos });
+  m_screen_manager->push_screen(std::move(session));
+
+  Benchmark benchmark(filename, args.replay.value_or(""));
+  m_screen_manager->run_benchmark(steps, std::move(replay));
+  benchmark.write_json(std::cout);
+}
+
+void
+Main::start_session(GameSession& session, int seed, const ReplayStart& start)
+{
+  gameRandom.seed(seed);
+  graphicsRandom.seed(0);
+
+  if (start.sector || start.spawnpoint)
+  {
+    std::string sectorname = start.sector.value_or(DEFAULT_SECTOR_NAME);
+
+    const auto& spawnpoints = session.get_current_sector().get_objects_by_type<SpawnPointMarker>();
+    std::string default_spawnpoint = (spawnpoints.begin() != spawnpoints.end()) ?
+      "" : spawnpoints.begin()->get_name();
+    std::string spawnpointname = start.spawnpoint.value_or(default_spawnpoint);
+
+    session.set_start_point(sectorname, spawnpointname);
+  }
+
+  if (start.tux_spawn_pos)
+  {
+    // FIXME: Specify start pos for multiple players
+    session.get_current_sector().get_players()[0]->set_pos(*start.tux_spawn_pos);
+  }
+
+  session.restart_level();
+}
+
 int
 Main::run(int argc, char** argv)
 {
@@ -38,6 +38,9 @@
 #include "supertux/tile_set.hpp"
 #include "video/ttf_surface_manager.hpp"
 
+class GameSession;
+struct ReplayStart;
+
 class ConfigSubsystem final
 {
 public:
@@ -97,6 +100,12 @@ private:
   void init_video();
 
   void launch_game(const CommandLineArguments& args);
+  void run_benchmark(const std::string& filename, const CommandLineArguments& args);
+
+  /** Seeds the random number generators, moves the player to the given
+      start and restarts the level. Shared by launch_game() and
+      run_benchmark(), so that a replay starts like it was recorded. */
+  void start_session(GameSession& session, int seed, const ReplayStart& start);
   void resave(const std::string& input_filename, const std::string& output_filename);
   void release_check();
 
@@ -68,6 +68,9 @@ DebugMenu::DebugMenu() :
   add_toggle(-1, _("Show Worldmap Path"), &g_debug.show_worldmap_path);
   add_toggle(-1, _("Show Controller"), &g_config->show_controller);
   add_toggle(-1, _("Show Framerate"), &g_config->show_fps);
+  add_toggle(-1, _("Show Profiler"),
+             []{ return g_debug.get_show_profiler(); },
+             [](bool value){ g_debug.set_show_profiler(value); });
   add_toggle(-1, _("Draw Redundant Frames"), &g_debug.draw_redundant_frames);
   add_toggle(-1, _("Show Player Position"), &g_config->show_player_pos);
   add_toggle(-1, _("Use Bitmap Fonts"),
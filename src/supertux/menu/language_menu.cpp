@@ -102,6 +102,7 @@ LanguageMenu::menu_action(MenuItem& item)
     }
   }
 
+  invalidate_translations();
   Resources::load();
 
   if (TitleScreen::current())
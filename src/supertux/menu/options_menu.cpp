@@ -64,6 +64,7 @@ OptionsMenu::OptionsMenu(Type type, bool complete) :
   m_window_resolutions(),
   m_resolutions(),
   m_vsyncs(),
+  m_target_fps_values(),
   m_sound_volumes(),
   m_music_volumes(),
   m_flash_intensity_values(),
@@ -120,10 +121,16 @@ OptionsMenu::refresh()
 
       add_magnification();
       add_vsync();
+      add_target_fps();
 
       add_toggle(MNID_FRAME_PREDICTION, _("Frame prediction"), &g_config->frame_prediction)
         .set_help(_("Smooth camera motion, generating intermediate frames. This has a noticeable effect on monitors at >> 60Hz. Moving objects may be blurry."));
 
+#ifndef __EMSCRIPTEN__
+      add_toggle(MNID_RENDER_THREAD, _("Render thread"), &g_config->render_thread)
+        .set_help(_("Render each frame on a separate thread while the next one is prepared. Only supported by the OpenGL renderer."));
+#endif
+
       add_toggle(MNID_FANCY_GFX, _("Fancy Effects"), &g_config->fancy_gfx)
         .set_help(_("Applies fancy effects such as blur, clear tile refraction, and various other effects deemed \"fancy\". May significantly degrade performance."));
 
@@ -463,6 +470,25 @@ OptionsMenu::add_vsync()
     .set_help(_("Set the VSync mode"));
 }
 
+void
+OptionsMenu::add_target_fps()
+{
+  m_target_fps_values.list = { _("off"), "30", "60", "75", "120", "144", "165", "240" };
+  m_target_fps_values.next = 0;
+
+  if (g_config->target_fps > 0)
+  {
+    const std::string value = std::to_string(g_config->target_fps);
+    auto it = std::find(m_target_fps_values.list.begin(), m_target_fps_values.list.end(), value);
+    if (it == m_target_fps_values.list.end())
+      it = m_target_fps_values.list.insert(m_target_fps_values.list.end(), value);
+    m_target_fps_values.next = static_cast<int>(it - m_target_fps_values.list.begin());
+  }
+
+  add_string_select(MNID_TARGET_FPS, _("Frame Rate Limit"), &m_target_fps_values.next, m_target_fps_values.list)
+    .set_help(_("Limit the number of frames drawn per second, independently of VSync. Useful with frame prediction to save power."));
+}
+
 void
 OptionsMenu::add_sound_volume()
 {
@@ -735,6 +761,13 @@ OptionsMenu::menu_action(MenuItem& item)
     }
     break;
 
+    case MNID_TARGET_FPS:
+      if (m_target_fps_values.next == 0)
+        g_config->target_fps = 0;
+      else
+        g_config->target_fps = std::stoi(m_target_fps_values.list[m_target_fps_values.next]);
+      break;
+
     case MNID_FULLSCREEN:
       VideoSystem::current()->apply_config();
       ScreenManager::current()->on_window_resize();
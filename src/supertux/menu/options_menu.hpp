@@ -51,6 +51,7 @@ private:
   void add_window_resolutions();
   void add_resolutions();
   void add_vsync();
+  void add_target_fps();
   void add_sound_volume();
   void add_music_volume();
   void add_flash_intensity();
@@ -66,7 +67,9 @@ private:
     MNID_MAGNIFICATION,
     MNID_ASPECTRATIO,
     MNID_VSYNC,
+    MNID_TARGET_FPS,
     MNID_FRAME_PREDICTION,
+    MNID_RENDER_THREAD,
     MNID_FANCY_GFX,
     MNID_SOUND,
     MNID_MUSIC,
@@ -103,6 +106,7 @@ private:
   StringOption m_window_resolutions;
   StringOption m_resolutions;
   StringOption m_vsyncs;
+  StringOption m_target_fps_values;
   StringOption m_sound_volumes;
   StringOption m_music_volumes;
   StringOption m_flash_intensity_values;
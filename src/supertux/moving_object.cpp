@@ -26,14 +26,16 @@
 
 MovingObject::MovingObject() :
   m_col(COLGROUP_MOVING, *this),
-  m_parent_dispenser()
+  m_parent_dispenser(),
+  m_always_active(false)
 {
 }
 
 MovingObject::MovingObject(const ReaderMapping& reader) :
   GameObject(reader),
   m_col(COLGROUP_MOVING, *this),
-  m_parent_dispenser()
+  m_parent_dispenser(),
+  m_always_active(false)
 {
   float height, width;
 
@@ -45,6 +47,7 @@ MovingObject::MovingObject(const ReaderMapping& reader) :
 
   reader.get("x", m_col.m_bbox.get_left());
   reader.get("y", m_col.m_bbox.get_top());
+  reader.get("always-active", m_always_active);
 }
 
 MovingObject::~MovingObject()
@@ -69,6 +72,7 @@ MovingObject::get_settings()
   }
   result.add_float(_("X"), &m_col.m_bbox.get_left(), "x", {}, OPTION_HIDDEN);
   result.add_float(_("Y"), &m_col.m_bbox.get_top(), "y", {}, OPTION_HIDDEN);
+  result.add_bool(_("Always active"), &m_always_active, "always-active", false);
 
   return result;
 }
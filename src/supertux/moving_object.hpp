@@ -103,6 +103,11 @@ public:
     return &m_col;
   }
 
+  /** Always active objects are never put to sleep when they are far
+      away from the active region of the sector, see
+      Sector::update_object_activation() */
+  virtual bool is_always_active() const { return m_always_active; }
+
   void set_parent_dispenser(Dispenser* dispenser);
   inline Dispenser* get_parent_dispenser() const { return m_parent_dispenser; }
 
@@ -164,6 +169,8 @@ protected:
 
   Dispenser* m_parent_dispenser;
 
+  bool m_always_active;
+
 private:
   MovingObject(const MovingObject&) = delete;
   MovingObject& operator=(const MovingObject&) = delete;
@@ -21,12 +21,16 @@
 #include "addon/addon_manager.hpp"
 #include "audio/sound_manager.hpp"
 #include "control/input_manager.hpp"
+#include "control/replay.hpp"
 #include "gui/dialog.hpp"
 #include "gui/menu_manager.hpp"
 #include "gui/mousecursor.hpp"
 #include "object/player.hpp"
+#include "physfs/util.hpp"
 #include "sdk/integration.hpp"
+#include "sprite/sprite_manager.hpp"
 #include "squirrel/squirrel_virtual_machine.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/console.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/controller_hud.hpp"
@@ -40,13 +44,21 @@
 #include "supertux/resources.hpp"
 #include "supertux/screen_fade.hpp"
 #include "supertux/sector.hpp"
+#include "util/file_system.hpp"
 #include "util/log.hpp"
+#include "util/profiler.hpp"
 #include "video/compositor.hpp"
 #include "video/drawing_context.hpp"
+#include "video/render_thread.hpp"
+#include "video/texture_manager.hpp"
+#include "video/video_system.hpp"
 
 #include <stdio.h>
+#include <algorithm>
 #include <chrono>
+#include <fmt/format.h>
 #include <iostream>
+#include <physfs.h>
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -63,9 +75,14 @@ struct ScreenManager::FPS_Stats
     last_fps(0),
     last_fps_min(0),
     last_fps_max(0),
+    last_p50_ms(0),
+    last_p95_ms(0),
+    last_p99_ms(0),
+    frame_times_us(),
     // Use chrono instead of SDL_GetTicks for more precise FPS measurement
     time_prev(std::chrono::steady_clock::now())
   {
+    frame_times_us.reserve(512);
   }
 
   void report_frame()
@@ -84,6 +101,7 @@ struct ScreenManager::FPS_Stats
       min_us = dtime_us;
     if (max_us < dtime_us)
       max_us = dtime_us;
+    frame_times_us.push_back(dtime_us);
 
     float expired_seconds = static_cast<float>(acc_us) / 1000000.0f;
     if (expired_seconds < 0.5f)
@@ -98,6 +116,10 @@ struct ScreenManager::FPS_Stats
     assert(min_us > 0);  // initialization to 1000000 and dtime_us > 0.
     last_fps_max = 1000000.0f / static_cast<float>(min_us);
     assert(last_fps_max > 0);  // min_us > 0.
+    last_p50_ms = percentile_ms(0.50f);
+    last_p95_ms = percentile_ms(0.95f);
+    last_p99_ms = percentile_ms(0.99f);
+    frame_times_us.clear();
     measurements_cnt = 0;
     acc_us = 0;
     min_us = 1000000;
@@ -108,6 +130,11 @@ struct ScreenManager::FPS_Stats
   inline float get_fps_min() const { return last_fps_min; }
   inline float get_fps_max() const { return last_fps_max; }
 
+  /** Frame time percentiles of the last measuring interval */
+  inline float get_p50_ms() const { return last_p50_ms; }
+  inline float get_p95_ms() const { return last_p95_ms; }
+  inline float get_p99_ms() const { return last_p99_ms; }
+
   // This returns the highest measured delay between two frames from the
   // previous and current 0.5 s measuring intervals
   float get_highest_max_ms() const
@@ -120,6 +147,16 @@ struct ScreenManager::FPS_Stats
     return previous_max_ms;
   }
 
+private:
+  float percentile_ms(float percentile)
+  {
+    assert(!frame_times_us.empty());
+    const size_t index = std::min(frame_times_us.size() - 1,
+                                  static_cast<size_t>(percentile * static_cast<float>(frame_times_us.size())));
+    std::nth_element(frame_times_us.begin(), frame_times_us.begin() + index, frame_times_us.end());
+    return static_cast<float>(frame_times_us[index]) / 1000.0f;
+  }
+
 private:
   int measurements_cnt;
   int acc_us;
@@ -128,6 +165,10 @@ private:
   float last_fps;
   float last_fps_min;
   float last_fps_max;
+  float last_p50_ms;
+  float last_p95_ms;
+  float last_p99_ms;
+  std::vector<int> frame_times_us;
   std::chrono::steady_clock::time_point time_prev;
 };
 
@@ -138,10 +179,20 @@ ScreenManager::ScreenManager(VideoSystem& video_system, InputManager& input_mana
   m_menu_manager(new MenuManager()),
   m_controller_hud(new ControllerHUD),
   m_mobile_controller(),
+  m_render_thread(),
+  m_compositors({ std::make_unique<Compositor>(video_system), std::make_unique<Compositor>(video_system) }),
+  m_current_compositor(0),
+  m_frame_pacer(),
   last_time(std::chrono::steady_clock::now()),
   elapsed_time(0.0f),
   seconds_per_step(1.0f / LOGICAL_FPS),
   m_fps_statistics(new FPS_Stats()),
+  m_replay_writer(),
+  m_replay_reader(),
+  m_record_directory(),
+  m_record_interval(1),
+  m_record_countdown(0),
+  m_recorded_frames(0),
   m_speed(1.0),
   m_actions(),
   m_screen_fade(),
@@ -151,6 +202,11 @@ ScreenManager::ScreenManager(VideoSystem& video_system, InputManager& input_mana
 
 ScreenManager::~ScreenManager()
 {
+  // Finish the frame in flight while the screens it draws still exist.
+  m_render_thread.reset();
+
+  if (!m_record_directory.empty())
+    log_info << "Recorded " << m_recorded_frames << " frames to '" << m_record_directory << "'" << std::endl;
 }
 
 void
@@ -231,6 +287,66 @@ ScreenManager::draw_fps(DrawingContext& context, FPS_Stats& fps_statistics)
   pos.x -= w2;
   context.color().draw_text(Resources::small_font, str1,
     pos, ALIGN_RIGHT, LAYER_HUD);
+
+  pos = Vector(context.get_width() - BORDER_X, pos.y + 15);
+  context.color().draw_text(Resources::small_font,
+    fmt::format("p50 {:.1f} / p95 {:.1f} / p99 {:.1f} ms",
+                fps_statistics.get_p50_ms(), fps_statistics.get_p95_ms(), fps_statistics.get_p99_ms()),
+    pos, ALIGN_RIGHT, LAYER_HUD);
+}
+
+void
+ScreenManager::draw_profiler(DrawingContext& context)
+{
+#ifdef ENABLE_PROFILER
+  const Profiler& profiler = Profiler::instance();
+
+  // Bars are scaled so that a full bar is the time available for one frame
+  // at the logical framerate.
+  const float budget_ms = 1000.0f / static_cast<float>(LOGICAL_FPS);
+  const float bar_width = 200.0f;
+  const float row_height = 16.0f;
+  const float label_width = Resources::small_font->get_text_width("SquirrelScheduler::update 99.99 ms");
+
+  Vector pos(BORDER_X, BORDER_Y + 80);
+  const float height = row_height * static_cast<float>(profiler.get_zone_count() + 3);
+  context.color().draw_filled_rect(Rectf(pos.x - 4.0f, pos.y - 4.0f,
+                                         pos.x + label_width + bar_width + 12.0f, pos.y + height + 4.0f),
+                                   Color(0.0f, 0.0f, 0.0f, 0.6f), LAYER_HUD);
+
+  auto draw_row = [&](const std::string& name, float ms, const Color& color) {
+    context.color().draw_text(Resources::small_font, fmt::format("{} {:.2f} ms", name, ms),
+                              pos, ALIGN_LEFT, LAYER_HUD);
+    const float width = std::min(ms / budget_ms, 1.0f) * bar_width;
+    context.color().draw_filled_rect(Rectf(pos.x + label_width + 8.0f, pos.y + 2.0f,
+                                           pos.x + label_width + 8.0f + width, pos.y + row_height - 2.0f),
+                                     color, LAYER_HUD);
+    pos.y += row_height;
+  };
+
+  draw_row("Frame", profiler.get_average_frame_ms(), Color(1.0f, 1.0f, 1.0f));
+  for (int i = 0; i < profiler.get_zone_count(); ++i)
+  {
+    const float ms = profiler.get_average_ms(i);
+    draw_row(profiler.get_zone_name(i), ms,
+             ms > budget_ms * 0.5f ? Color(1.0f, 0.3f, 0.2f) : Color(0.3f, 0.9f, 0.3f));
+  }
+
+  // The compositor being recorded was last rendered a frame before the
+  // one in flight, so it isn't touched by the render thread right now.
+  const Compositor& compositor = *m_compositors[m_current_compositor];
+  context.color().draw_text(Resources::small_font,
+                            fmt::format("Draw arena {} / {} KiB",
+                                        (compositor.get_arena_used() + 1023) / 1024,
+                                        (compositor.get_arena_capacity() + 1023) / 1024),
+                            pos, ALIGN_LEFT, LAYER_HUD);
+  pos.y += row_height;
+  context.color().draw_text(Resources::small_font,
+                            fmt::format("Back buffer {} / {} frames",
+                                        Compositor::s_back_buffer_frames.load(),
+                                        Compositor::s_frames.load()),
+                            pos, ALIGN_LEFT, LAYER_HUD);
+#endif
 }
 
 void
@@ -261,6 +377,8 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
 {
   assert(!m_screen_stack.empty());
 
+  SpriteManager::current()->update_animation_clock();
+
   // draw the actual screen
   m_screen_stack.back()->draw(compositor);
 
@@ -280,6 +398,9 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
   if (g_config->show_fps)
     draw_fps(context, fps_statistics);
 
+  if (g_debug.get_show_profiler())
+    draw_profiler(context);
+
   if (g_config->show_controller) {
     m_controller_hud->draw(context);
   }
@@ -287,9 +408,74 @@ ScreenManager::draw(Compositor& compositor, FPS_Stats& fps_statistics)
   if (g_config->show_player_pos) {
     draw_player_pos(context);
   }
+}
+
+Compositor&
+ScreenManager::begin_frame(float time_offset)
+{
+  m_current_compositor = (m_current_compositor + 1) % m_compositors.size();
+
+  Compositor& compositor = *m_compositors[m_current_compositor];
+  compositor.begin_frame(time_offset);
+  return compositor;
+}
+
+void
+ScreenManager::render_frame(Compositor& compositor)
+{
+  if (!m_record_directory.empty() && m_record_countdown-- == 0)
+  {
+    m_record_countdown = m_record_interval - 1;
+    compositor.add_capture(FileSystem::join(m_record_directory, fmt::format("frame{:06d}.png", m_recorded_frames++)),
+                           false);
+  }
+
+  const std::string screenshot = m_video_system.take_screenshot_request();
+  if (!screenshot.empty())
+    compositor.add_capture(screenshot);
+
+  // Before submitting, so that the uploads are finished when the
+  // RenderThread draws the frame.
+  TextureManager::current()->upload_pending();
+
+  if (m_render_thread)
+  {
+    m_render_thread->submit(compositor);
+
+    // submit() waited for the previous frame to be rendered.
+    m_compositors[(m_current_compositor + 1) % m_compositors.size()]->publish_pixels();
+  }
+  else
+  {
+    compositor.render();
+    compositor.publish_pixels();
+  }
+
+  m_video_system.poll_screenshots();
+}
+
+void
+ScreenManager::update_render_thread()
+{
+  const bool enabled = g_config->render_thread && m_video_system.supports_render_thread();
+  if (enabled == static_cast<bool>(m_render_thread))
+    return;
+
+  if (!enabled)
+  {
+    m_render_thread.reset();
+    return;
+  }
 
-  // render everything
-  compositor.render();
+  try
+  {
+    m_render_thread = std::make_unique<RenderThread>(m_video_system);
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << "Couldn't start render thread: " << err.what() << std::endl;
+    g_config->render_thread = false;
+  }
 }
 
 void
@@ -303,10 +489,23 @@ ScreenManager::update_gamelogic(float dt_sec)
     m_mobile_controller.apply(controller);
   }
 
-  SquirrelVirtualMachine::current()->update(g_game_time);
+  if (m_replay_reader)
+  {
+    m_replay_reader->apply(controller);
+  }
+  else if (m_replay_writer)
+  {
+    m_replay_writer->record(controller);
+  }
+
+  {
+    Benchmark::Scope scope(Benchmark::SCRIPTS);
+    SquirrelVirtualMachine::current()->update(g_game_time);
+  }
 
   if (!m_screen_stack.empty())
   {
+    Benchmark::Scope scope(Benchmark::UPDATE);
     m_screen_stack.back()->update(dt_sec, controller);
   }
 
@@ -442,7 +641,12 @@ ScreenManager::process_events()
         break;
 
       case SDL_KEYDOWN:
-        if (event.key.keysym.sym == SDLK_F10)
+        if (event.key.keysym.sym == SDLK_F10 &&
+            event.key.keysym.mod & KMOD_SHIFT)
+        {
+          g_debug.set_show_profiler(!g_debug.get_show_profiler());
+        }
+        else if (event.key.keysym.sym == SDLK_F10)
         {
           g_config->show_fps = !g_config->show_fps;
         }
@@ -572,6 +776,8 @@ ScreenManager::handle_screen_switch()
 
 void ScreenManager::loop_iter()
 {
+  update_render_thread();
+
   auto now = std::chrono::steady_clock::now();
   auto nsecs = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_time).count();
   elapsed_time += 1e-9f * static_cast<float>(nsecs);
@@ -591,7 +797,8 @@ void ScreenManager::loop_iter()
   if (elapsed_time < seconds_per_step && !always_draw) {
     // Sleep a bit because not enough time has passed since the previous
     // logical game step
-    SDL_Delay(static_cast<Uint32>(1000.0f * (seconds_per_step - elapsed_time)));
+    m_frame_pacer.sleep_until(now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                std::chrono::duration<float>(seconds_per_step - elapsed_time)));
     return;
   }
 
@@ -645,12 +852,18 @@ void ScreenManager::loop_iter()
   if ((steps > 0 && !m_screen_stack.empty())
       || always_draw) {
     // Draw a frame
-    Compositor compositor(m_video_system, g_config->frame_prediction ? time_offset : 0.0f);
+    Compositor& compositor = begin_frame(g_config->frame_prediction ? time_offset : 0.0f);
     draw(compositor, *m_fps_statistics);
+    render_frame(compositor);
     m_fps_statistics->report_frame();
+
+    if (m_frame_pacer.get_target_fps() != static_cast<float>(g_config->target_fps))
+      m_frame_pacer.set_target_fps(static_cast<float>(g_config->target_fps));
+    m_frame_pacer.wait_for_next_frame();
   }
 
   SoundManager::current()->update();
+  PROFILE_FRAME_END();
 
   handle_screen_switch();
 
@@ -668,6 +881,68 @@ static void g_loop_iter() {
 }
 #endif
 
+void
+ScreenManager::set_replay_writer(std::unique_ptr<ReplayWriter> writer)
+{
+  m_replay_writer = std::move(writer);
+}
+
+void
+ScreenManager::set_frame_recording(const std::string& directory, int interval)
+{
+  if (!PHYSFS_exists(directory.c_str()) && !PHYSFS_mkdir(directory.c_str()))
+    throw std::runtime_error(fmt::format("Couldn't create '{}' for recording frames: {}", directory,
+                                         physfsutil::get_last_error()));
+
+  m_record_directory = directory;
+  m_record_interval = std::max(interval, 1);
+  m_record_countdown = 0;
+  m_recorded_frames = 0;
+
+  log_info << "Recording one in every " << m_record_interval << " frames to '" << directory << "'" << std::endl;
+}
+
+void
+ScreenManager::run_benchmark(int steps, std::unique_ptr<ReplayReader> replay)
+{
+  m_replay_reader = std::move(replay);
+
+  handle_screen_switch();
+  for (int i = 0; i < steps && !m_screen_stack.empty(); ++i)
+  {
+    update_render_thread();
+
+    // Mirror a single step of loop_iter(), so that a replay recorded during
+    // regular play advances the game in exactly the same way.
+    float dtime = seconds_per_step * m_speed * g_debug.get_game_speed_multiplier();
+    g_game_time += dtime;
+    g_real_time += seconds_per_step;
+    m_input_manager.update();
+    update_gamelogic(dtime);
+
+    {
+      Benchmark::Scope scope(Benchmark::DRAW);
+      Compositor& compositor = begin_frame(0.0f);
+      draw(compositor, *m_fps_statistics);
+      render_frame(compositor);
+    }
+    m_fps_statistics->report_frame();
+
+    SoundManager::current()->update();
+    PROFILE_FRAME_END();
+
+    handle_screen_switch();
+
+    if (auto* benchmark = Benchmark::current())
+      benchmark->finish_frame();
+  }
+
+  if (auto* benchmark = Benchmark::current())
+    benchmark->set_video(m_video_system.get_name(), static_cast<bool>(m_render_thread));
+
+  m_replay_reader.reset();
+}
+
 void
 ScreenManager::run()
 {
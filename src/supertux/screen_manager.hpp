@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <memory>
 #include <SDL.h>
@@ -25,6 +26,7 @@
 
 #include "control/mobile_controller.hpp"
 #include "squirrel/squirrel_thread_queue.hpp"
+#include "supertux/frame_pacer.hpp"
 #include "supertux/screen.hpp"
 #include "util/currenton.hpp"
 
@@ -34,6 +36,9 @@ class DrawingContext;
 class InputManager;
 class MenuManager;
 class MenuStorage;
+class ReplayReader;
+class RenderThread;
+class ReplayWriter;
 class ScreenFade;
 class VideoSystem;
 
@@ -47,6 +52,18 @@ public:
   ~ScreenManager() override;
 
   void run();
+
+  /** Runs a fixed number of logical steps as fast as possible, without
+      sleeping or polling for events, drawing one frame per step */
+  void run_benchmark(int steps, std::unique_ptr<ReplayReader> replay);
+
+  /** Records the controller state of every logical step until the
+      ScreenManager is destroyed */
+  void set_replay_writer(std::unique_ptr<ReplayWriter> writer);
+
+  /** Writes every interval-th rendered frame as a numbered PNG into the
+      given directory of the user data, without dropping frames */
+  void set_frame_recording(const std::string& directory, int interval);
   void quit(std::unique_ptr<ScreenFade> fade = {});
   inline void set_speed(float speed) { m_speed = speed; }
   inline float get_speed() const { return m_speed; }
@@ -66,8 +83,12 @@ public:
 private:
   struct FPS_Stats;
   void draw_fps(DrawingContext& context, FPS_Stats& fps_statistics);
+  void draw_profiler(DrawingContext& context);
   void draw_player_pos(DrawingContext& context);
   void draw(Compositor& compositor, FPS_Stats& fps_statistics);
+  Compositor& begin_frame(float time_offset);
+  void render_frame(Compositor& compositor);
+  void update_render_thread();
   void update_gamelogic(float dt_sec);
   void process_events();
   void handle_screen_switch();
@@ -80,11 +101,30 @@ private:
   std::unique_ptr<ControllerHUD> m_controller_hud;
   MobileController m_mobile_controller;
 
+  /** Renders the frames while the next one is recorded, if enabled */
+  std::unique_ptr<RenderThread> m_render_thread;
+
+  /** Frames are recorded into these in turn, so that one can be recorded
+      while the RenderThread renders the other */
+  std::array<std::unique_ptr<Compositor>, 2> m_compositors;
+  size_t m_current_compositor;
+
+  FramePacer m_frame_pacer;
+
   std::chrono::steady_clock::time_point last_time;
   float elapsed_time;
   const float seconds_per_step;
   std::unique_ptr<FPS_Stats> m_fps_statistics;
 
+  std::unique_ptr<ReplayWriter> m_replay_writer;
+  std::unique_ptr<ReplayReader> m_replay_reader;
+
+  /** Directory frames are recorded to, empty if they aren't */
+  std::string m_record_directory;
+  int m_record_interval;
+  int m_record_countdown;
+  int m_recorded_frames;
+
   float m_speed;
   struct Action
   {
@@ -46,6 +46,7 @@
 #include "object/vertical_stripes.hpp"
 #include "physfs/ifile_stream.hpp"
 #include "squirrel/squirrel_environment.hpp"
+#include "supertux/benchmark.hpp"
 #include "supertux/colorscheme.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/debug.hpp"
@@ -56,12 +57,24 @@
 #include "supertux/tile.hpp"
 #include "supertux/tile_manager.hpp"
 #include "util/file_system.hpp"
+#include "util/profiler.hpp"
 #include "util/writer.hpp"
 #include "video/video_system.hpp"
 #include "video/viewport.hpp"
 
 Sector* Sector::s_current = nullptr;
 
+namespace {
+
+/** Number of ticks between two passes of update_object_activation() */
+const int ACTIVATION_INTERVAL = 8;
+
+/** Objects are put to sleep only this far outside of the active region,
+    so that objects close to its border don't toggle every pass */
+const float SLEEP_MARGIN = 256.0f;
+
+} // namespace
+
 Sector::Sector(Level& parent) :
   Base::Sector("sector"),
   m_level(parent),
@@ -71,7 +84,8 @@ Sector::Sector(Level& parent) :
   m_collision_system(new CollisionSystem(*this)),
   m_text_object(add<TextObject>("Text")),
   m_init_script_run(),
-  m_init_script_run_once()
+  m_init_script_run_once(),
+  m_activation_ticks(0)
 {
   add<DisplayEffect>("Effect");
   add<TextArrayObject>("TextArray");
@@ -272,6 +286,7 @@ Sector::activate(const Vector& player_pos)
   }
 
   flush_game_objects();
+  update_object_activation(true);
 
   //Run default.nut just before init script
   //Check to see if it's in a levelset (info file)
@@ -314,6 +329,43 @@ Sector::deactivate()
   s_current = nullptr;
 }
 
+void
+Sector::update_object_activation(bool force)
+{
+  if (Editor::is_active())
+    return;
+
+  if (!force && ++m_activation_ticks < ACTIVATION_INTERVAL)
+    return;
+  m_activation_ticks = 0;
+
+  const Rectf active_region = get_active_region();
+  const Rectf sleep_region = active_region.grown(SLEEP_MARGIN);
+
+  std::vector<CollisionObject*> fallen_asleep;
+  for (auto& object : get_objects_by_type<MovingObject>())
+  {
+    if (!object.is_valid())
+      continue;
+
+    if (object.is_sleeping())
+    {
+      if (object.get_bbox().overlaps(active_region) || object.is_always_active())
+      {
+        set_object_sleeping(object, false);
+        m_collision_system->add(object.get_collision_object());
+      }
+    }
+    else if (!object.is_always_active() && !object.get_bbox().overlaps(sleep_region))
+    {
+      set_object_sleeping(object, true);
+      fallen_asleep.push_back(object.get_collision_object());
+    }
+  }
+
+  m_collision_system->remove_sleeping(fallen_asleep);
+}
+
 Rectf
 Sector::get_active_region() const
 {
@@ -361,6 +413,8 @@ Sector::in_worldmap() const
 void
 Sector::update(float dt_sec)
 {
+  PROFILE_ZONE("Sector::update");
+
   assert(m_initialized);
 
   BIND_SECTOR(*this);
@@ -371,12 +425,19 @@ Sector::update(float dt_sec)
   m_last_translation = camera.get_translation();
   m_last_dt = dt_sec;
 
-  m_squirrel_environment->update(dt_sec);
+  {
+    Benchmark::Scope scope(Benchmark::SCRIPTS);
+    m_squirrel_environment->update(dt_sec);
+  }
 
+  update_object_activation(false);
   GameObjectManager::update(dt_sec);
 
   /* Handle all possible collisions. */
-  m_collision_system->update();
+  {
+    Benchmark::Scope scope(Benchmark::COLLISION);
+    m_collision_system->update();
+  }
   flush_game_objects();
 }
 
@@ -739,6 +800,17 @@ Sector::get_nearby_objects(const Vector& center, float max_distance) const
   return result;
 }
 
+std::vector<MovingObject*>
+Sector::query_objects(const Rectf& rect) const
+{
+  std::vector<MovingObject*> result;
+  for (auto& object : m_collision_system->get_objects_in(rect))
+  {
+    result.push_back(&object->get_parent());
+  }
+  return result;
+}
+
 void
 Sector::stop_looping_sounds()
 {
@@ -902,6 +974,7 @@ Sector::register_class(ssq::VM& vm)
   cls.addFunc<bool, Sector, float, float, float, float, bool>("is_free_of_statics", &Sector::is_free_of_statics);
   cls.addFunc<bool, Sector, float, float, float, float>("is_free_of_movingstatics", &Sector::is_free_of_movingstatics);
   cls.addFunc<bool, Sector, float, float, float, float>("is_free_of_specifically_movingstatics", &Sector::is_free_of_specifically_movingstatics);
+  cls.addFunc("change_solid_tiles", &Sector::change_solid_tiles);
 
   cls.addVar("gravity", &Sector::m_gravity);
 }
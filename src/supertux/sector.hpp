@@ -200,6 +200,36 @@ public:
 
   std::vector<MovingObject*> get_nearby_objects (const Vector& center, float max_distance) const;
 
+  /** Returns all awake objects whose bounding box overlaps @c rect.
+      Backed by the spatial hash of the collision system. */
+  std::vector<MovingObject*> query_objects(const Rectf& rect) const;
+
+  /** Returns all awake objects of type T overlapping @c rect. */
+  template<class T>
+  std::vector<T*> query(const Rectf& rect) const
+  {
+    std::vector<T*> result;
+    for (auto* object : query_objects(rect))
+    {
+      if (auto* typed = dynamic_cast<T*>(object))
+        result.push_back(typed);
+    }
+    return result;
+  }
+
+  /** Returns all awake objects of type T within @c radius of @c center. */
+  template<class T>
+  std::vector<T*> query_radius(const Vector& center, float radius) const
+  {
+    std::vector<T*> result;
+    for (auto* object : get_nearby_objects(center, radius))
+    {
+      if (auto* typed = dynamic_cast<T*>(object))
+        result.push_back(typed);
+    }
+    return result;
+  }
+
   Rectf get_active_region() const;
 
   inline int get_foremost_opaque_layer() const { return m_foremost_opaque_layer; }
@@ -211,7 +241,12 @@ public:
   /** resize all tilemaps with given size */
   void resize(const Size& old_size, const Size& new_size, const Size& resize_offset);
 
-  /** globally changes solid tilemaps' tile ids */
+  /**
+   * @scripting
+   * @description Changes all tiles with ID ""old_tile_id"" in the sector's solid tilemaps to ""new_tile_id"".
+   * @param int $old_tile_id
+   * @param int $new_tile_id
+   */
   void change_solid_tiles(uint32_t old_tile_id, uint32_t new_tile_id);
 
   /**
@@ -243,6 +278,11 @@ private:
 
   int calculate_foremost_layer(bool including_transparent = true) const;
 
+  /** Puts moving objects that are far outside of the active region to
+      sleep and wakes up those that entered it again. Runs every few
+      ticks only, unless forced. */
+  void update_object_activation(bool force);
+
   /** Convert tiles into their corresponding GameObjects (e.g.
       bonusblocks, add light to lava tiles) */
   void convert_tiles2gameobject();
@@ -271,6 +311,8 @@ private:
   bool m_init_script_run;
   bool m_init_script_run_once;
 
+  int m_activation_ticks;
+
  public: 
   // The default sector size.
   static const int DEFAULT_SECTOR_WIDTH = 350;
@@ -189,12 +189,15 @@ Statistics::draw_worldmap_info(DrawingContext& context, float target_time)
     WMAP_INFO_TOP_Y2 = WMAP_INFO_TOP_Y1 + 16;
   }
 
+  static const TranslatedString s_header(N_("Best Level Statistics"),
+                                         [](const std::string& header) { return "- " + header + " -"; });
+
   context.color().draw_text(
-    Resources::small_font, "- " + _("Best Level Statistics") + " -",
+    Resources::small_font, s_header,
     Vector((WMAP_INFO_LEFT_X + WMAP_INFO_RIGHT_X) / 2, WMAP_INFO_TOP_Y1),
     ALIGN_CENTER, LAYER_HUD,Statistics::header_color);
 
-  std::string caption_buf;
+  const std::string* caption_buf = nullptr;
   std::string stat_buf;
   float posy = WMAP_INFO_TOP_Y2;
   Color tcolor;
@@ -207,7 +210,7 @@ Statistics::draw_worldmap_info(DrawingContext& context, float target_time)
         if (!m_preferences.enable_coins)
           continue;
 
-        caption_buf = CAPTION_MAX_COINS;
+        caption_buf = &CAPTION_MAX_COINS;
         stat_buf = coins_to_string(m_coins, m_total_coins);
         if (m_coins >= m_total_coins)
           tcolor = Statistics::perfect_color;
@@ -216,7 +219,7 @@ Statistics::draw_worldmap_info(DrawingContext& context, float target_time)
         if (!m_preferences.enable_badguys)
           continue;
 
-        caption_buf = CAPTION_MAX_FRAGGING;
+        caption_buf = &CAPTION_MAX_FRAGGING;
         stat_buf = frags_to_string(m_badguys, m_total_badguys);
         if (m_badguys >= m_total_badguys)
           tcolor = Statistics::perfect_color;
@@ -225,26 +228,25 @@ Statistics::draw_worldmap_info(DrawingContext& context, float target_time)
         if (!m_preferences.enable_secrets)
           continue;
 
-        caption_buf = CAPTION_MAX_SECRETS;
+        caption_buf = &CAPTION_MAX_SECRETS;
         stat_buf = secrets_to_string(m_secrets, m_total_secrets);
         if (m_secrets >= m_total_secrets)
           tcolor = Statistics::perfect_color;
         break;
       case 3:
-        caption_buf = CAPTION_BEST_TIME;
+        caption_buf = &CAPTION_BEST_TIME;
         stat_buf = time_to_string(m_time);
         if ((m_time < target_time) || (target_time == 0.0f))
           tcolor = Statistics::perfect_color;
         break;
       case 4:
         if (target_time != 0.0f) { // display target time only if defined for level
-          caption_buf = CAPTION_TARGET_TIME;
+          caption_buf = &CAPTION_TARGET_TIME;
           stat_buf = time_to_string(target_time);
           if ((m_time < target_time) || (target_time == 0.0f))
             tcolor = Statistics::perfect_color;
         } else {
-          caption_buf = "";
-          stat_buf = "";
+          continue;
         }
         break;
       default:
@@ -252,7 +254,7 @@ Statistics::draw_worldmap_info(DrawingContext& context, float target_time)
         continue;
     }
 
-    context.color().draw_text(Resources::small_font, caption_buf, Vector(WMAP_INFO_LEFT_X, posy), ALIGN_LEFT, LAYER_HUD, Statistics::header_color);
+    context.color().draw_text(Resources::small_font, *caption_buf, Vector(WMAP_INFO_LEFT_X, posy), ALIGN_LEFT, LAYER_HUD, Statistics::header_color);
     context.color().draw_text(Resources::small_font, stat_buf, Vector(WMAP_INFO_RIGHT_X, posy), ALIGN_RIGHT, LAYER_HUD, tcolor);
     posy += Resources::small_font->get_height() + 2;
   }
@@ -270,6 +272,13 @@ Statistics::draw_endseq_panel(DrawingContext& context, Statistics* best_stats, c
   constexpr float padding_bottom = 10.f;
   constexpr float label_indent = 16.f;
 
+  static const TranslatedString s_you(N_("You"));
+  static const TranslatedString s_best(N_("Best"));
+  static const TranslatedString s_time(N_("Time"));
+  static const TranslatedString s_coins(N_("Coins"));
+  static const TranslatedString s_badguys(N_("Badguys"));
+  static const TranslatedString s_secrets(N_("Secrets"));
+
   int visible_rows = 1;
   if (m_preferences.enable_coins)   ++visible_rows;
   if (m_preferences.enable_badguys) ++visible_rows;
@@ -303,9 +312,9 @@ Statistics::draw_endseq_panel(DrawingContext& context, Statistics* best_stats, c
   context.pop_transform();
 
   const float header_y = box_y + header_padding_top;
-  context.color().draw_text(Resources::normal_font, _("You"), Vector(col_x_positions[1], header_y), ALIGN_LEFT, layer, Statistics::header_color);
+  context.color().draw_text(Resources::normal_font, s_you, Vector(col_x_positions[1], header_y), ALIGN_LEFT, layer, Statistics::header_color);
   if (best_stats)
-    context.color().draw_text(Resources::normal_font, _("Best"), Vector(col_x_positions[2], header_y), ALIGN_LEFT, layer, Statistics::header_color);
+    context.color().draw_text(Resources::normal_font, s_best, Vector(col_x_positions[2], header_y), ALIGN_LEFT, layer, Statistics::header_color);
 
   float y = box_y + padding_top;
 
@@ -313,7 +322,7 @@ Statistics::draw_endseq_panel(DrawingContext& context, Statistics* best_stats, c
   if (target_time == 0.0f || (m_time != 0.0f && m_time < target_time))
     tcolor = Statistics::perfect_color;
 
-  context.color().draw_text(Resources::normal_font, _("Time"), Vector(col_x_positions[1] - label_indent, y), ALIGN_RIGHT, layer, Statistics::header_color);
+  context.color().draw_text(Resources::normal_font, s_time, Vector(col_x_positions[1] - label_indent, y), ALIGN_RIGHT, layer, Statistics::header_color);
   context.color().draw_text(Resources::normal_font, time_to_string(m_time), Vector(col_x_positions[1], y), ALIGN_LEFT, layer, tcolor);
   if (best_stats)
   {
@@ -329,7 +338,7 @@ Statistics::draw_endseq_panel(DrawingContext& context, Statistics* best_stats, c
   {
     y += row_height;
 
-    context.color().draw_text(Resources::normal_font, _("Coins"), Vector(col_x_positions[1] - label_indent, y), ALIGN_RIGHT, layer, Statistics::header_color);
+    context.color().draw_text(Resources::normal_font, s_coins, Vector(col_x_positions[1] - label_indent, y), ALIGN_RIGHT, layer, Statistics::header_color);
 
     if (m_coins >= m_total_coins)
       tcolor = Statistics::perfect_color;
@@ -357,7 +366,7 @@ Statistics::draw_endseq_panel(DrawingContext& context, Statistics* best_stats, c
       tcolor = Statistics::perfect_color;
     else
       tcolor = Statistics::text_color;
-    context.color().draw_text(Resources::normal_font, _("Badguys"), Vector(col_x_positions[1] - label_indent, y), ALIGN_RIGHT, layer, Statistics::header_color);
+    context.color().draw_text(Resources::normal_font, s_badguys, Vector(col_x_positions[1] - label_indent, y), ALIGN_RIGHT, layer, Statistics::header_color);
     context.color().draw_text(Resources::normal_font, frags_to_string(m_badguys, m_total_badguys), Vector(col_x_positions[1], y), ALIGN_LEFT, layer, tcolor);
 
     if (best_stats)
@@ -380,7 +389,7 @@ Statistics::draw_endseq_panel(DrawingContext& context, Statistics* best_stats, c
       tcolor = Statistics::perfect_color;
     else
       tcolor = Statistics::text_color;
-    context.color().draw_text(Resources::normal_font, _("Secrets"), Vector(col_x_positions[1] - label_indent, y), ALIGN_RIGHT, layer, Statistics::header_color);
+    context.color().draw_text(Resources::normal_font, s_secrets, Vector(col_x_positions[1] - label_indent, y), ALIGN_RIGHT, layer, Statistics::header_color);
     context.color().draw_text(Resources::normal_font, secrets_to_string(m_secrets, m_total_secrets), Vector(col_x_positions[1], y), ALIGN_LEFT, layer, tcolor);
 
     if (best_stats)
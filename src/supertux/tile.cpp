@@ -19,6 +19,7 @@
 #include "supertux/tile.hpp"
 
 #include "math/aatriangle.hpp"
+#include "sprite/sprite_manager.hpp"
 #include "supertux/constants.hpp"
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
@@ -50,6 +51,8 @@ Tile::Tile() :
   m_attributes(0),
   m_data(0),
   m_fps(1),
+  m_frame_tick(0),
+  m_frame_number(0),
   m_object_name(),
   m_object_data(),
   m_deprecated(false)
@@ -67,6 +70,8 @@ Tile::Tile(const std::vector<SurfacePtr>& images,
   m_attributes(attributes),
   m_data(data),
   m_fps(fps),
+  m_frame_tick(0),
+  m_frame_number(0),
   m_object_name(obj_name),
   m_object_data(obj_data),
   m_deprecated(deprecated)
@@ -77,21 +82,13 @@ void
 Tile::draw(Canvas& canvas, const Vector& pos, int z_pos, const Color& color) const
 {
   if (draw_editor_images && m_editor_images.size() > 0) {
-    size_t frame_no = 0;
-    if (m_editor_images.size() > 1) {
-      frame_no = size_t(g_game_time * m_fps) % m_editor_images.size();
-    }
-    canvas.draw_surface(m_editor_images[frame_no], pos, 0, color, Blend(), z_pos);
+    canvas.draw_surface(get_current_editor_surface(), pos, 0, color, Blend(), z_pos);
     return;
   }
 
   if(m_images.size() > 0)
   {
-    size_t frame_no = 0;
-    if (m_images.size() > 1) {
-      frame_no = size_t(g_game_time * m_fps) % m_images.size();
-    }
-    canvas.draw_surface(m_images[frame_no], pos, 0, color, Blend(), z_pos);
+    canvas.draw_surface(get_current_surface(), pos, 0, color, Blend(), z_pos);
   }
 }
 
@@ -205,25 +202,40 @@ Tile::draw_debug(Canvas& canvas, const Vector& pos, int z_pos, const Color& colo
   }
 }
 
-SurfacePtr
+size_t
+Tile::get_frame_number() const
+{
+  const SpriteManager* sprite_manager = SpriteManager::current();
+  if (!sprite_manager)
+    return size_t(g_game_time * m_fps);
+
+  if (m_frame_tick != sprite_manager->get_animation_tick())
+  {
+    m_frame_tick = sprite_manager->get_animation_tick();
+    m_frame_number = size_t(sprite_manager->get_animation_time() * m_fps);
+  }
+  return m_frame_number;
+}
+
+const SurfacePtr&
 Tile::get_current_surface() const
 {
+  static const SurfacePtr no_surface;
+
   if (m_images.size() > 1) {
-    size_t frame = size_t(g_game_time * m_fps) % m_images.size();
-    return m_images[frame];
+    return m_images[get_frame_number() % m_images.size()];
   } else if (m_images.size() == 1) {
     return m_images[0];
   } else {
-    return {};
+    return no_surface;
   }
 }
 
-SurfacePtr
+const SurfacePtr&
 Tile::get_current_editor_surface() const
 {
   if (m_editor_images.size() > 1) {
-    size_t frame = size_t(g_game_time * m_fps) % m_editor_images.size();
-    return m_editor_images[frame];
+    return m_editor_images[get_frame_number() % m_editor_images.size()];
   } else if (m_editor_images.size() == 1) {
     return m_editor_images[0];
   } else {
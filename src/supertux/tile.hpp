@@ -108,8 +108,9 @@ public:
   void draw(Canvas& canvas, const Vector& pos, int z_pos, const Color& color = Color(1, 1, 1)) const;
   void draw_debug(Canvas& canvas, const Vector& pos, int z_pos, const Color& color = Color(1.0f, 0.f, 1.0f, 0.5f)) const;
 
-  SurfacePtr get_current_surface() const;
-  SurfacePtr get_current_editor_surface() const;
+  /** Return the current frame of the tile, null if it has no images */
+  const SurfacePtr& get_current_surface() const;
+  const SurfacePtr& get_current_editor_surface() const;
 
   inline uint32_t get_attributes() const { return m_attributes; }
   inline int get_data() const { return m_data; }
@@ -145,6 +146,10 @@ public:
   inline const std::string& get_object_data() const { return m_object_data; }
 
 private:
+  /** Number of frames played since the start of the SpriteManager's
+      animation clock, computed once per animation tick */
+  size_t get_frame_number() const;
+
   /** Returns zero if a unisolid tile is non-solid due to the movement
       direction, non-zero if the tile is solid due to direction. */
   bool check_movement_unisolid (const Vector& movement) const;
@@ -166,6 +171,9 @@ private:
 
   float m_fps;
 
+  mutable uint32_t m_frame_tick;
+  mutable size_t m_frame_number;
+
   std::string m_object_name;
   std::string m_object_data;
 
@@ -17,6 +17,7 @@
 
 #include "supertux/tile_set_parser.hpp"
 
+#include <chrono>
 #include <sstream>
 #include <sexp/value.hpp>
 #include <sexp/io.hpp>
@@ -29,7 +30,10 @@
 #include "util/reader_document.hpp"
 #include "util/reader_mapping.hpp"
 #include "util/file_system.hpp"
+#include "util/profiler.hpp"
+#include "util/string_util.hpp"
 #include "video/surface.hpp"
+#include "video/texture_manager.hpp"
 
 TileSetParser::TileSetParser(TileSet& tileset, const std::string& filename,
                              int32_t start, int32_t end, int32_t offset) :
@@ -61,6 +65,9 @@ TileSetParser::parse(bool imported)
     m_start = 1;
   }
 
+  PROFILE_ZONE("TileSetParser::parse");
+  const auto start_time = std::chrono::steady_clock::now();
+
   m_tiles_path = FileSystem::dirname(m_filename);
 
   auto doc = ReaderDocument::from_file(m_filename);
@@ -70,6 +77,8 @@ TileSetParser::parse(bool imported)
     throw std::runtime_error("file is not a supertux tiles file.");
   }
 
+  preload_images(root.get_mapping());
+
   auto iter = root.get_mapping().get_iter();
   while (iter.next())
   {
@@ -219,6 +228,60 @@ TileSetParser::parse(bool imported)
   {
     m_tileset.add_unassigned_tilegroup();
   }
+
+  if (!imported)
+  {
+    // Images of tiles outside of an imported range are never requested.
+    TextureManager::current()->drop_preloaded();
+
+    log_info << "Tileset '" << m_filename << "' loaded in "
+             << std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_time).count()
+             << " ms" << std::endl;
+  }
+}
+
+void
+TileSetParser::preload_images(const ReaderMapping& root) const
+{
+  std::vector<std::string> files;
+
+  auto iter = root.get_iter();
+  while (iter.next())
+  {
+    if (iter.get_key() != "tile" && iter.get_key() != "tiles")
+      continue;
+
+    ReaderMapping reader = iter.as_mapping();
+    for (const char* key : { "images", "editor-images" })
+    {
+      std::optional<ReaderMapping> images_mapping;
+      if (!reader.get(key, images_mapping))
+        continue;
+
+      // Same forms as accepted by parse_imagespecs(); "(surface ...)"
+      // entries and ".surface" files are left to the regular path.
+      auto images_iter = images_mapping->get_iter();
+      while (images_iter.next())
+      {
+        std::string file;
+        if (images_iter.is_string())
+        {
+          file = images_iter.as_string_item();
+        }
+        else if (images_iter.is_pair() && images_iter.get_key() == "region")
+        {
+          auto const& arr = images_iter.as_mapping().get_sexp().as_array();
+          if (arr.size() == 6 && arr[1].is_string())
+            file = arr[1].as_string();
+        }
+
+        if (!file.empty() && !StringUtil::has_suffix(file, ".surface"))
+          files.push_back(FileSystem::join(m_tiles_path, file));
+      }
+    }
+  }
+
+  TextureManager::current()->preload(files);
 }
 
 void
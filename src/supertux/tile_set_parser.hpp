@@ -47,6 +47,10 @@ public:
 private:
   void parse_tile(const ReaderMapping& reader);
   void parse_tiles(const ReaderMapping& reader);
+
+  /** Decodes the images of all tiles in \a root up front, in parallel,
+      instead of one after the other as the tiles are parsed */
+  void preload_images(const ReaderMapping& root) const;
   std::vector<SurfacePtr> parse_imagespecs(const ReaderMapping& cur,
                                            const std::optional<Rect>& region = std::nullopt) const;
 
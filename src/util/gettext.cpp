@@ -17,3 +17,34 @@
 #include "util/gettext.hpp"
 
 std::unique_ptr<tinygettext::DictionaryManager> g_dictionary_manager = nullptr;
+
+namespace {
+
+unsigned int s_translation_generation = 1;
+
+} // namespace
+
+TranslatedString::TranslatedString(const char* message, Decorate decorate) :
+  m_message(message),
+  m_decorate(decorate),
+  m_translation(),
+  m_generation(0)
+{
+}
+
+const std::string&
+TranslatedString::get() const
+{
+  if (m_generation != s_translation_generation)
+  {
+    m_translation = m_decorate ? m_decorate(_(m_message)) : _(m_message);
+    m_generation = s_translation_generation;
+  }
+  return m_translation;
+}
+
+void
+invalidate_translations()
+{
+  ++s_translation_generation;
+}
@@ -18,6 +18,7 @@
 
 #include <tinygettext/tinygettext.hpp>
 #include <memory>
+#include <string>
 
 extern std::unique_ptr<tinygettext::DictionaryManager> g_dictionary_manager;
 
@@ -83,3 +84,46 @@ static inline std::string __(const std::string& message,
     return message_plural;
   }
 }
+
+/** Marks a string literal for translation without translating it, see
+    TranslatedString. */
+constexpr const char* N_(const char* message)
+{
+  return message;
+}
+
+/** A constant message that is translated only once per language, for
+    text drawn every frame, where _() would look up and copy the
+    translation each time. The message has to be a string literal
+    marked with N_():
+
+        static const TranslatedString s_close(N_("Close"));
+        context.color().draw_text(font, s_close, pos, ALIGN_LEFT, layer);
+
+    Text around the message that isn't translated, like decorations, is
+    added by \a decorate, so that it isn't put together every frame.
+ */
+class TranslatedString final
+{
+public:
+  using Decorate = std::string (*)(const std::string& translation);
+
+public:
+  explicit TranslatedString(const char* message, Decorate decorate = nullptr);
+
+  /** Returns the translation, which stays valid until the language
+      changes */
+  const std::string& get() const;
+  inline operator const std::string&() const { return get(); }
+
+private:
+  const char* m_message;
+  Decorate m_decorate;
+  mutable std::string m_translation;
+  mutable unsigned int m_generation;
+};
+
+/** Makes all TranslatedStrings look up their translation again. Has to
+    be called whenever the language or the translation directories of
+    g_dictionary_manager change. */
+void invalidate_translations();
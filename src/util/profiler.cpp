@@ -0,0 +1,201 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "util/profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+
+#include "physfs/ofile_stream.hpp"
+#include "util/log.hpp"
+
+namespace {
+
+thread_local uint8_t s_thread_id = 1;
+thread_local uint8_t s_depth = 0;
+
+} // namespace
+
+Profiler Profiler::s_instance;
+bool Profiler::s_enabled = false;
+
+int
+Profiler::register_zone(const char* name)
+{
+  Profiler& profiler = s_instance;
+  for (int i = 0; i < profiler.m_zone_count; ++i)
+  {
+    if (std::strcmp(profiler.m_zone_names[i], name) == 0)
+      return i;
+  }
+
+  if (profiler.m_zone_count >= MAX_ZONES)
+  {
+    log_warning << "Too many profiler zones, merging '" << name << "' into '"
+                << profiler.m_zone_names[MAX_ZONES - 1] << "'" << std::endl;
+    return MAX_ZONES - 1;
+  }
+
+  profiler.m_zone_names[profiler.m_zone_count] = name;
+  return profiler.m_zone_count++;
+}
+
+void
+Profiler::set_enabled(bool enabled)
+{
+  if (enabled && !s_instance.m_events)
+    s_instance.m_events.reset(new Event[RING_BUFFER_SIZE]);
+
+  s_enabled = enabled;
+}
+
+void
+Profiler::set_thread_id(int id)
+{
+  s_thread_id = static_cast<uint8_t>(id);
+}
+
+Profiler::Profiler() :
+  m_epoch(std::chrono::steady_clock::now()),
+  m_zone_names(),
+  m_zone_count(0),
+  m_mutex(),
+  m_events(),
+  m_next_event(0),
+  m_event_count(0),
+  m_frame(0),
+  m_frame_start_ns(0),
+  m_current_frame_ns(),
+  m_history_ns(),
+  m_history_frame_ns(),
+  m_history_frames(0)
+{
+}
+
+int64_t
+Profiler::now_ns() const
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - m_epoch).count();
+}
+
+int64_t
+Profiler::begin_zone()
+{
+  ++s_depth;
+  return now_ns();
+}
+
+void
+Profiler::end_zone(int id, int64_t start_ns)
+{
+  const int64_t duration_ns = now_ns() - start_ns;
+  --s_depth;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_events[m_next_event] = { start_ns, duration_ns, m_frame,
+                             static_cast<uint16_t>(id), s_depth, s_thread_id };
+  m_next_event = (m_next_event + 1) % RING_BUFFER_SIZE;
+  m_event_count = std::min(m_event_count + 1, RING_BUFFER_SIZE);
+
+  m_current_frame_ns[id] += duration_ns;
+}
+
+void
+Profiler::frame_end()
+{
+  const int64_t now = now_ns();
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (s_enabled)
+  {
+    const int slot = static_cast<int>(m_frame % HISTORY_FRAMES);
+    m_history_ns[slot] = m_current_frame_ns;
+    m_history_frame_ns[slot] = now - m_frame_start_ns;
+    m_history_frames = std::min(m_history_frames + 1, HISTORY_FRAMES);
+  }
+
+  m_current_frame_ns.fill(0);
+  m_frame_start_ns = now;
+  ++m_frame;
+}
+
+float
+Profiler::get_average_ms(int id) const
+{
+  if (m_history_frames == 0)
+    return 0.0f;
+
+  int64_t total_ns = 0;
+  for (int i = 0; i < m_history_frames; ++i)
+    total_ns += m_history_ns[i][id];
+
+  return static_cast<float>(total_ns) / static_cast<float>(m_history_frames) / 1000000.0f;
+}
+
+float
+Profiler::get_average_frame_ms() const
+{
+  if (m_history_frames == 0)
+    return 0.0f;
+
+  int64_t total_ns = 0;
+  for (int i = 0; i < m_history_frames; ++i)
+    total_ns += m_history_frame_ns[i];
+
+  return static_cast<float>(total_ns) / static_cast<float>(m_history_frames) / 1000000.0f;
+}
+
+bool
+Profiler::export_chrome_trace(const std::string& filename) const
+{
+  if (!m_events || m_event_count == 0)
+  {
+    log_warning << "No profiler data recorded, enable the profiler first" << std::endl;
+    return false;
+  }
+
+  OFileStream out(filename);
+  if (!out)
+  {
+    log_warning << "Couldn't open '" << filename << "' for writing" << std::endl;
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+  const size_t first = (m_next_event + RING_BUFFER_SIZE - m_event_count) % RING_BUFFER_SIZE;
+  for (size_t i = 0; i < m_event_count; ++i)
+  {
+    const Event& event = m_events[(first + i) % RING_BUFFER_SIZE];
+    out << fmt::format("{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f},"
+                       "\"args\":{{\"frame\":{}}}}}{}\n",
+                       m_zone_names[event.zone],
+                       event.thread,
+                       static_cast<double>(event.start_ns) / 1000.0,
+                       static_cast<double>(event.duration_ns) / 1000.0,
+                       event.frame,
+                       i + 1 < m_event_count ? "," : "");
+  }
+
+  out << "]}\n";
+
+  log_info << "Wrote " << m_event_count << " profiler events to '" << filename << "'" << std::endl;
+  return true;
+}
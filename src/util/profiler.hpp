@@ -0,0 +1,152 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <config.h>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+
+/**
+ * Low-overhead instrumentation of hot code paths.
+ *
+ * Zones are recorded into a fixed-size ring buffer, which can be written out
+ * in the Chrome trace event format, and summed up per frame for the
+ * on-screen overlay. Nothing is recorded unless the profiler is enabled, and
+ * with ENABLE_PROFILER unset, the PROFILE_* macros expand to nothing.
+ */
+class Profiler final
+{
+public:
+  static constexpr int MAX_ZONES = 32;
+  static constexpr int HISTORY_FRAMES = 64;
+  static constexpr size_t RING_BUFFER_SIZE = 1 << 16;
+
+  class Zone final
+  {
+  public:
+    Zone(int id) :
+      m_id(id),
+      m_start(s_enabled ? s_instance.begin_zone() : -1)
+    {
+    }
+
+    ~Zone()
+    {
+      // Zones opened before the profiler got enabled are not recorded
+      if (m_start >= 0)
+        s_instance.end_zone(m_id, m_start);
+    }
+
+  private:
+    int m_id;
+    int64_t m_start;
+
+  private:
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+  };
+
+private:
+  struct Event
+  {
+    int64_t start_ns;
+    int64_t duration_ns;
+    uint32_t frame;
+    uint16_t zone;
+    uint8_t depth;
+    uint8_t thread;
+  };
+
+public:
+  static Profiler& instance() { return s_instance; }
+
+  /** Returns the id of the zone with the given name, names must be
+      string literals or otherwise outlive the profiler */
+  static int register_zone(const char* name);
+
+  static inline bool is_enabled() { return s_enabled; }
+  static void set_enabled(bool enabled);
+
+  /** Zones of other threads than the main thread (id 1) are shown on
+      their own track in the exported trace */
+  static void set_thread_id(int id);
+
+private:
+  static Profiler s_instance;
+  static bool s_enabled;
+
+public:
+  Profiler();
+
+  void frame_end();
+
+  /** Writes the contents of the ring buffer in the Chrome trace event
+      format (chrome://tracing, Perfetto) to a PhysFS path */
+  bool export_chrome_trace(const std::string& filename) const;
+
+  inline int get_zone_count() const { return m_zone_count; }
+  inline const char* get_zone_name(int id) const { return m_zone_names[id]; }
+
+  /** Average inclusive time of the zone per frame over the recent history */
+  float get_average_ms(int id) const;
+  float get_average_frame_ms() const;
+
+private:
+  int64_t begin_zone();
+  void end_zone(int id, int64_t start_ns);
+  int64_t now_ns() const;
+
+private:
+  std::chrono::steady_clock::time_point m_epoch;
+  std::array<const char*, MAX_ZONES> m_zone_names;
+  int m_zone_count;
+
+  /** Guards the recorded events and per-frame sums, zones may end on
+      the render thread */
+  mutable std::mutex m_mutex;
+
+  std::unique_ptr<Event[]> m_events;
+  size_t m_next_event;
+  size_t m_event_count;
+
+  uint32_t m_frame;
+  int64_t m_frame_start_ns;
+
+  std::array<int64_t, MAX_ZONES> m_current_frame_ns;
+  std::array<std::array<int64_t, MAX_ZONES>, HISTORY_FRAMES> m_history_ns;
+  std::array<int64_t, HISTORY_FRAMES> m_history_frame_ns;
+  int m_history_frames;
+
+private:
+  Profiler(const Profiler&) = delete;
+  Profiler& operator=(const Profiler&) = delete;
+};
+
+#ifdef ENABLE_PROFILER
+#  define PROFILE_ZONE(name)                                            \
+  static const int s_profile_zone_id = Profiler::register_zone(name); \
+  const Profiler::Zone profile_zone(s_profile_zone_id)
+#  define PROFILE_FRAME_END() Profiler::instance().frame_end()
+#else
+#  define PROFILE_ZONE(name)
+#  define PROFILE_FRAME_END()
+#endif
@@ -19,10 +19,46 @@
 #include <sexp/parser.hpp>
 #include <sstream>
 
-#include "physfs/ifile_stream.hpp"
+#include "physfs/ifile_data.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 
+namespace {
+
+/** Read-only streambuf over a memory block, lets the parser consume
+    mapped file contents without copying them */
+class MemoryStreambuf final : public std::streambuf
+{
+public:
+  MemoryStreambuf(const char* data, size_t size)
+  {
+    char* begin = const_cast<char*>(data);
+    setg(begin, begin, begin + size);
+  }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode mode) override
+  {
+    off_type pos = off;
+    if (dir == std::ios_base::cur)
+      pos += gptr() - eback();
+    else if (dir == std::ios_base::end)
+      pos += egptr() - eback();
+    return seekpos(static_cast<pos_type>(pos), mode);
+  }
+
+  pos_type seekpos(pos_type pos, std::ios_base::openmode) override
+  {
+    if (pos < 0 || pos > egptr() - eback())
+      return pos_type(off_type(-1));
+    setg(eback(), eback() + static_cast<off_type>(pos), egptr());
+    return pos;
+  }
+};
+
+} // namespace
+
 ReaderDocument
 ReaderDocument::from_string(const std::string& string, const std::string& filename, int depth)
 {
@@ -42,7 +78,9 @@ ReaderDocument::from_file(const std::string& filename, int depth)
 {
   log_debug << "ReaderDocument::parse: " << filename << std::endl;
 
-  IFileStream in(filename);
+  IFileData data(filename);
+  MemoryStreambuf buf(data.data(), data.size());
+  std::istream in(&buf);
   if (!in.good()) {
     std::stringstream msg;
     msg << "Parser problem: Couldn't open file '" << filename << "'.";
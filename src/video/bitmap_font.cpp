@@ -309,56 +309,28 @@ BitmapFont::get_height() const
   return static_cast<float>(char_height);
 }
 
-std::string
-BitmapFont::wrap_to_width(const std::string& s_, float width, std::string* overflow)
+size_t
+BitmapFont::get_fitting_length(const std::string& line, float width) const
 {
-  std::string s = s_;
-
-  // If text is already smaller, return full text.
-  if (get_text_width(s) <= width) {
-    if (overflow) *overflow = "";
-    return s;
-  }
+  float curr_width = 0;
+  std::string::size_type char_begin = 0;
 
-  // If we can find a whitespace character to break at, return text up to this character.
-  for (int i = static_cast<int>(s.length()) - 1; i >= 0; i--) {
-    std::string s2 = s.substr(0,i);
-    if (s[i] != ' ') continue;
-    if (get_text_width(s2) <= width) {
-      if (overflow) *overflow = s.substr(i+1);
-      return s.substr(0, i);
-    }
-  }
+  for (UTF8Iterator it(line); !it.done(); ++it)
+  {
+    if ( glyphs.at(*it).surface_idx != -1 )
+      curr_width += glyphs[*it].advance;
+    else
+      curr_width += glyphs[0x20].advance;
 
-  // Hard-wrap at width, taking care of multibyte characters.
-  unsigned int char_bytes = 1;
-  for (int i = 0; i < static_cast<int>(s.length()); i += char_bytes) {
-
-    // Calculate the number of bytes in the character.
-    char_bytes = 1;
-    auto iter = s.begin() + i + 1; // Iter points to next byte.
-    while ( iter != s.end() && (*iter & 128) && !(*iter & 64) ) {
-      // This is a "continuation" byte in the form 10xxxxxx.
-      ++iter;
-      ++char_bytes;
-    }
+    if (curr_width > width)
+      return char_begin;
 
-    // Check whether text now goes over allowed width, and if so
-    // return everything up to the character and put the rest in the overflow.
-    std::string s2 = s.substr(0,i+char_bytes);
-    if (get_text_width(s2) > width) {
-      if (i == 0) i += char_bytes; // Edge case when even one char is too wide.
-      if (overflow) *overflow = s.substr(i);
-      return s.substr(0, i);
-    }
+    char_begin = it.pos;
   }
 
-  // Should in theory never reach here.
-  if (overflow) *overflow = "";
-  return s;
+  return line.size();
 }
 
-
 Rectf
 BitmapFont::draw_text(Canvas& canvas, const std::string& text,
                       const Vector& pos, FontAlignment alignment, int layer, const Color& color)
@@ -66,14 +66,12 @@ public:
    */
   virtual float get_height() const override;
 
-  /**
-   * returns the given string, truncated (preferably at whitespace) to be at most "width" pixels wide
-   */
-  virtual std::string wrap_to_width(const std::string& text, float width, std::string* overflow) override;
-
   virtual Rectf draw_text(Canvas& canvas, const std::string& text,
                           const Vector& pos, FontAlignment alignment, int layer, const Color& color) override;
 
+protected:
+  virtual size_t get_fitting_length(const std::string& line, float width) const override;
+
 private:
   friend class DrawingContext;
 
@@ -18,10 +18,12 @@
 
 #include <algorithm>
 #include <array>
+#include <functional>
 
 #include "supertux/globals.hpp"
 #include "util/log.hpp"
 #include "util/obstackpp.hpp"
+#include "util/profiler.hpp"
 #include "video/drawing_context.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
@@ -29,10 +31,63 @@
 #include "video/surface.hpp"
 #include "video/video_system.hpp"
 
+namespace {
+
+template<typename T>
+void hash_combine(size_t& seed, const T& value)
+{
+  seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+void hash_combine(size_t& seed, const Rectf& rect)
+{
+  hash_combine(seed, rect.get_left());
+  hash_combine(seed, rect.get_top());
+  hash_combine(seed, rect.get_right());
+  hash_combine(seed, rect.get_bottom());
+}
+
+void hash_combine(size_t& seed, const Color& color)
+{
+  hash_combine(seed, color.red);
+  hash_combine(seed, color.green);
+  hash_combine(seed, color.blue);
+  hash_combine(seed, color.alpha);
+}
+
+bool is_additive_texture(const DrawingRequest& request)
+{
+  return request.get_type() == RequestType::TEXTURE &&
+         request.blend == Blend::ADD &&
+         !static_cast<const TextureRequest&>(request).displacement_texture;
+}
+
+bool can_batch(const DrawingRequest& lhs, const DrawingRequest& rhs)
+{
+  if (lhs.get_type() != RequestType::TEXTURE ||
+      rhs.get_type() != RequestType::TEXTURE)
+    return false;
+
+  const auto& lhs_texture = static_cast<const TextureRequest&>(lhs);
+  const auto& rhs_texture = static_cast<const TextureRequest&>(rhs);
+
+  return lhs.layer == rhs.layer &&
+         lhs.flip == rhs.flip &&
+         lhs.alpha == rhs.alpha &&
+         lhs.blend == rhs.blend &&
+         lhs.viewport == rhs.viewport &&
+         lhs_texture.texture == rhs_texture.texture &&
+         lhs_texture.displacement_texture == rhs_texture.displacement_texture &&
+         lhs_texture.color == rhs_texture.color;
+}
+
+} // namespace
+
 Canvas::Canvas(DrawingContext& context, obstack& obst) :
   m_context(context),
   m_obst(obst),
-  m_requests()
+  m_requests(),
+  m_pixels()
 {
   m_requests.reserve(500);
 }
@@ -53,8 +108,10 @@ Canvas::clear()
 }
 
 void
-Canvas::render(Renderer& renderer, Filter filter)
+Canvas::render(Renderer& renderer, Filter filter, int max_layer)
 {
+  PROFILE_ZONE("Canvas::render");
+
   // On a regular level, each frame has around 50-250 requests (before
   // batching it was 1000-3000), the sort comparator function is
   // called approximatly 3-7 times for each request.
@@ -63,12 +120,18 @@ Canvas::render(Renderer& renderer, Filter filter)
                      return r1->layer < r2->layer;
                    });
 
+  batch_requests();
+
   Painter& painter = renderer.get_painter();
 
   for (const auto& i : m_requests)
   {
     const DrawingRequest& request = *i;
 
+    // The requests are sorted by layer.
+    if (request.layer > max_layer)
+      break;
+
     if (filter == BELOW_LIGHTMAP && request.layer >= LAYER_LIGHTMAP)
       continue;
     else if (filter == ABOVE_LIGHTMAP && request.layer <= LAYER_LIGHTMAP)
@@ -103,14 +166,116 @@ Canvas::render(Renderer& renderer, Filter filter)
         break;
 
       case RequestType::GETPIXEL:
-        painter.get_pixel(static_cast<const GetPixelRequest&>(request));
+      {
+        const auto& pixel_request = static_cast<const GetPixelRequest&>(request);
+        m_pixels.emplace_back(pixel_request.color_ptr, painter.get_pixel(pixel_request));
         break;
+      }
     }
   }
 
   painter.clear_clip_rect();
 }
 
+void
+Canvas::batch_requests()
+{
+  // Additive blending is commutative, so runs of additive requests on the
+  // same layer can be sorted by texture, which mostly brings together
+  // the many copies of the same light sprite.
+  for (auto it = m_requests.begin(); it != m_requests.end();)
+  {
+    if (!is_additive_texture(**it))
+    {
+      ++it;
+      continue;
+    }
+
+    const int layer = (*it)->layer;
+    const auto end = std::find_if(it, m_requests.end(),
+                                  [layer](const DrawingRequest* request) {
+                                    return request->layer != layer || !is_additive_texture(*request);
+                                  });
+
+    std::stable_sort(it, end,
+                     [](const DrawingRequest* r1, const DrawingRequest* r2) {
+                       return std::less<const Texture*>()(static_cast<const TextureRequest*>(r1)->texture,
+                                                          static_cast<const TextureRequest*>(r2)->texture);
+                     });
+    it = end;
+  }
+
+  auto out = m_requests.begin();
+  for (auto it = m_requests.begin(); it != m_requests.end(); ++it)
+  {
+    if (out != m_requests.begin() && can_batch(**(out - 1), **it))
+    {
+      auto& batch = static_cast<TextureRequest&>(**(out - 1));
+      auto& request = static_cast<TextureRequest&>(**it);
+
+      batch.srcrects.insert(batch.srcrects.end(), request.srcrects.begin(), request.srcrects.end());
+      batch.dstrects.insert(batch.dstrects.end(), request.dstrects.begin(), request.dstrects.end());
+      batch.angles.insert(batch.angles.end(), request.angles.begin(), request.angles.end());
+
+      request.~TextureRequest();
+    }
+    else
+    {
+      *out++ = *it;
+    }
+  }
+  m_requests.erase(out, m_requests.end());
+}
+
+std::optional<size_t>
+Canvas::get_signature() const
+{
+  size_t hash = m_requests.size();
+
+  for (const auto* request : m_requests)
+  {
+    if (request->get_type() != RequestType::TEXTURE)
+      return std::nullopt;
+
+    const auto& texture_request = static_cast<const TextureRequest&>(*request);
+
+    hash_combine(hash, request->layer);
+    hash_combine(hash, static_cast<int>(request->flip));
+    hash_combine(hash, request->alpha);
+    hash_combine(hash, static_cast<int>(request->blend));
+    hash_combine(hash, Rectf(request->viewport));
+    hash_combine(hash, texture_request.texture);
+    hash_combine(hash, texture_request.displacement_texture);
+    hash_combine(hash, texture_request.color);
+
+    for (const auto& rect : texture_request.srcrects)
+      hash_combine(hash, rect);
+    for (const auto& rect : texture_request.dstrects)
+      hash_combine(hash, rect);
+    for (const auto angle : texture_request.angles)
+      hash_combine(hash, angle);
+  }
+
+  return hash;
+}
+
+std::optional<int>
+Canvas::get_displacement_layer() const
+{
+  std::optional<int> layer;
+
+  for (const auto* request : m_requests)
+  {
+    if (request->get_type() == RequestType::TEXTURE &&
+        request->layer < LAYER_LIGHTMAP &&
+        static_cast<const TextureRequest&>(*request).displacement_texture &&
+        (!layer || request->layer > *layer))
+      layer = request->layer;
+  }
+
+  return layer;
+}
+
 void
 Canvas::draw_surface(const SurfacePtr& surface,
                      const Vector& position, float angle, const Color& color, const Blend& blend,
@@ -165,6 +330,15 @@ Canvas::draw_surface_part(const SurfacePtr& surface, const Rectf& srcrect, const
 {
   if (!surface) return;
 
+  const auto& cliprect = m_context.get_cliprect();
+
+  // Discard clipped surface.
+  if (dstrect.get_left() > cliprect.get_right() ||
+      dstrect.get_top() > cliprect.get_bottom() ||
+      dstrect.get_right() < cliprect.get_left() ||
+      dstrect.get_bottom() < cliprect.get_top())
+    return;
+
   auto request = new(m_obst) TextureRequest(m_context.transform());
 
   request->layer = layer;
@@ -308,10 +482,35 @@ Canvas::draw_line(const Vector& pos1, const Vector& pos2, const Color& color, in
 
   request->layer  = layer;
 
-  request->pos          = apply_translate(pos1)*scale();
+  request->line         = { apply_translate(pos1)*scale(), apply_translate(pos2)*scale() };
+  request->color        = color;
+  request->color.alpha  = color.alpha * m_context.transform().alpha;
+
+  m_requests.push_back(request);
+}
+
+void
+Canvas::draw_lines(std::vector<Vector> points, const Color& color, int layer)
+{
+  if (points.size() < 2) return;
+
+  draw_lines(std::make_shared<const std::vector<Vector>>(std::move(points)), color, layer);
+}
+
+void
+Canvas::draw_lines(std::shared_ptr<const std::vector<Vector>> points, const Color& color, int layer)
+{
+  if (!points || points->size() < 2) return;
+
+  auto request = new(m_obst) LineRequest(m_context.transform());
+
+  request->layer  = layer;
+
+  request->lines        = std::move(points);
+  request->offset       = apply_translate(Vector(0.0f, 0.0f));
+  request->scale        = scale();
   request->color        = color;
   request->color.alpha  = color.alpha * m_context.transform().alpha;
-  request->dest_pos     = apply_translate(pos2)*scale();
 
   m_requests.push_back(request);
 }
@@ -365,7 +564,7 @@ Canvas::get_pixel(const Vector& position, const std::shared_ptr<Color>& color_ou
       pos.x < 0.0f ||
       pos.y < 0.0f)
   {
-    *color_out = Color(0, 0, 0);
+    m_pixels.emplace_back(color_out, Color(0, 0, 0));
     return;
   }
 
@@ -378,6 +577,13 @@ Canvas::get_pixel(const Vector& position, const std::shared_ptr<Color>& color_ou
   m_requests.push_back(request);
 }
 
+void
+Canvas::take_pixels(std::vector<std::pair<std::shared_ptr<Color>, Color>>& pixels)
+{
+  pixels.insert(pixels.end(), m_pixels.begin(), m_pixels.end());
+  m_pixels.clear();
+}
+
 Vector
 Canvas::apply_translate(const Vector& pos) const
 {
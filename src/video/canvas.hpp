@@ -17,9 +17,12 @@
 
 #pragma once
 
+#include <limits>
 #include <string>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <utility>
 #include <obstack.h>
 
 #include "math/rectf.hpp"
@@ -79,6 +82,12 @@ public:
   void draw_inverse_ellipse(const Vector& pos, const Vector& size, const Color& color, int layer);
 
   void draw_line(const Vector& pos1, const Vector& pos2, const Color& color, int layer);
+  /** Draws a line between every pair of points, with a single request */
+  void draw_lines(std::vector<Vector> points, const Color& color, int layer);
+  /** Like above, but the points are shared instead of copied, so that
+      callers can keep them across frames. They must not be modified
+      afterwards, as the frame may be rendered on another thread. */
+  void draw_lines(std::shared_ptr<const std::vector<Vector>> points, const Color& color, int layer);
   void draw_triangle(const Vector& pos1, const Vector& pos2, const Vector& pos3, const Color& color, int layer);
 
   /** Draw a flat-topped regular hexagon
@@ -94,12 +103,32 @@ public:
   /** on next update, set color to lightmap's color at position */
   void get_pixel(const Vector& position, const std::shared_ptr<Color>& color_out);
 
+  /** Moves the pixels read by the last render() to @c pixels, for
+      Compositor::publish_pixels() */
+  void take_pixels(std::vector<std::pair<std::shared_ptr<Color>, Color>>& pixels);
+
   void clear();
-  void render(Renderer& renderer, Filter filter);
+
+  /** Renders the requests passing @c filter, leaving out the ones
+      above @c max_layer */
+  void render(Renderer& renderer, Filter filter, int max_layer = std::numeric_limits<int>::max());
+
+  /** Returns the highest layer below the lightmap with a request that
+      has a displacement texture, or std::nullopt if there is none */
+  std::optional<int> get_displacement_layer() const;
+
+  /** Returns a hash of the requests, which is equal for two frames that
+      draw the same, or std::nullopt if they can't be compared, as they
+      include requests other than textures */
+  std::optional<size_t> get_signature() const;
 
   inline DrawingContext& get_context() { return m_context; }
 
 private:
+  /** Merges neighbouring requests of the same texture into one, so that
+      they are drawn with a single draw call */
+  void batch_requests();
+
   Vector apply_translate(const Vector& pos) const;
   float scale() const;
 
@@ -108,6 +137,10 @@ private:
   obstack& m_obst;
   std::vector<DrawingRequest*> m_requests;
 
+  /** Colors read by get_pixel() requests, with their destination, which
+      must not be written while the frame may be rendered on another thread */
+  std::vector<std::pair<std::shared_ptr<Color>, Color>> m_pixels;
+
 private:
   Canvas(const Canvas&) = delete;
   Canvas& operator=(const Canvas&) = delete;
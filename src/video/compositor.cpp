@@ -17,7 +17,12 @@
 
 #include "video/compositor.hpp"
 
+#include <assert.h>
+#include <functional>
+#include <optional>
+
 #include "math/rect.hpp"
+#include "util/profiler.hpp"
 #include "video/drawing_context.hpp"
 #include "video/drawing_request.hpp"
 #include "video/painter.hpp"
@@ -25,32 +30,133 @@
 #include "video/video_system.hpp"
 
 bool Compositor::s_render_lighting = true;
+std::atomic<uint32_t> Compositor::s_frames(0);
+std::atomic<uint32_t> Compositor::s_back_buffer_frames(0);
 
-Compositor::Compositor(VideoSystem& video_system, float time_offset) :
+Compositor::Compositor(VideoSystem& video_system) :
   m_video_system(video_system),
   m_obst(),
+  m_obst_base(),
   m_drawing_contexts(),
-  m_time_offset(time_offset)
+  m_unused_contexts(),
+  m_time_offset(0.0f),
+  m_captures(),
+  m_pixels(),
+  m_arena_used(0),
+  m_arena_capacity(0)
 {
   obstack_init(&m_obst);
+  m_obst_base = obstack_base(&m_obst);
+  m_arena_capacity = static_cast<size_t>(obstack_memory_used(&m_obst));
 }
 
 Compositor::~Compositor()
 {
   m_drawing_contexts.clear();
+  m_unused_contexts.clear();
   obstack_free(&m_obst, nullptr);
 }
 
+void
+Compositor::begin_frame(float time_offset)
+{
+  assert(m_drawing_contexts.empty());
+  m_time_offset = time_offset;
+}
+
 DrawingContext&
 Compositor::make_context(bool overlay)
 {
-  m_drawing_contexts.emplace_back(new DrawingContext(m_video_system, m_obst, overlay, m_time_offset));
+  if (m_unused_contexts.empty())
+  {
+    m_drawing_contexts.emplace_back(new DrawingContext(m_video_system, m_obst, overlay, m_time_offset));
+  }
+  else
+  {
+    m_drawing_contexts.push_back(std::move(m_unused_contexts.back()));
+    m_unused_contexts.pop_back();
+    m_drawing_contexts.back()->reset(overlay, m_time_offset);
+  }
   return *m_drawing_contexts.back();
 }
 
+void
+Compositor::add_capture(const std::string& filename, bool verbose)
+{
+  m_captures.emplace_back(filename, verbose);
+}
+
+void
+Compositor::publish_pixels()
+{
+  for (const auto& [color_out, color] : m_pixels)
+    *color_out = color;
+  m_pixels.clear();
+}
+
+void
+Compositor::reset_arena()
+{
+  const size_t capacity = static_cast<size_t>(obstack_memory_used(&m_obst));
+
+  if (!m_obst.chunk->prev)
+  {
+    m_arena_used = static_cast<size_t>(obstack_next_free(&m_obst) - static_cast<char*>(m_obst_base));
+    obstack_free(&m_obst, m_obst_base);
+  }
+  else
+  {
+    // The requests didn't fit into the first chunk. Replace the chunks
+    // with a single one that is large enough to hold all of them, so
+    // that the following frames don't allocate anymore.
+    m_arena_used = capacity;
+    obstack_free(&m_obst, nullptr);
+    obstack_begin(&m_obst, static_cast<int>(capacity));
+    m_obst_base = obstack_base(&m_obst);
+  }
+
+  m_arena_capacity = static_cast<size_t>(obstack_memory_used(&m_obst));
+}
+
+bool
+Compositor::is_lightmap_current(Renderer& lightmap) const
+{
+  size_t signature = 0;
+
+  for (const auto& ctx : m_drawing_contexts)
+  {
+    if (ctx->is_overlay())
+      continue;
+
+    const std::optional<size_t> light_signature = ctx->light().get_signature();
+    if (!light_signature)
+    {
+      lightmap.set_content_signature(0);
+      return false;
+    }
+
+    const Color& ambient_color = ctx->get_ambient_color();
+    signature = signature * 31 + *light_signature;
+    signature = signature * 31 + std::hash<float>()(ambient_color.red);
+    signature = signature * 31 + std::hash<float>()(ambient_color.green);
+    signature = signature * 31 + std::hash<float>()(ambient_color.blue);
+  }
+
+  // Never report 0, which stands for unknown content.
+  signature |= 1;
+
+  if (lightmap.get_texture() && lightmap.get_content_signature() == signature)
+    return true;
+
+  lightmap.set_content_signature(signature);
+  return false;
+}
+
 void
 Compositor::render()
 {
+  PROFILE_ZONE("Compositor::render");
+
   auto& lightmap = m_video_system.get_lightmap();
 
   bool use_lightmap = std::any_of(m_drawing_contexts.begin(), m_drawing_contexts.end(),
@@ -60,8 +166,8 @@ Compositor::render()
 
   use_lightmap = use_lightmap && s_render_lighting;
 
-  // Prepare lightmap.
-  if (use_lightmap)
+  // Prepare lightmap, unless it already holds what this frame would draw.
+  if (use_lightmap && !is_lightmap_current(lightmap))
   {
     lightmap.start_draw();
     Painter& painter = lightmap.get_painter();
@@ -78,18 +184,40 @@ Compositor::render()
     lightmap.end_draw();
   }
 
+  // The back buffer is only sampled by requests with a displacement
+  // texture, so it is skipped on frames without any. Otherwise only the
+  // contexts and layers up to the last of them are rendered into it,
+  // as everything above is drawn over them on the screen anyway.
   auto back_renderer = m_video_system.get_back_renderer();
   if (back_renderer)
   {
-    back_renderer->start_draw();
-
-    for (auto& ctx : m_drawing_contexts)
+    size_t last_ctx = 0;
+    std::optional<int> last_layer;
+    for (size_t i = 0; i < m_drawing_contexts.size(); ++i)
     {
-      ctx->color().render(*back_renderer, Canvas::BELOW_LIGHTMAP);
+      if (const auto layer = m_drawing_contexts[i]->color().get_displacement_layer())
+      {
+        last_ctx = i;
+        last_layer = layer;
+      }
     }
 
-    back_renderer->end_draw();
+    if (last_layer)
+    {
+      back_renderer->start_draw();
+
+      for (size_t i = 0; i < last_ctx; ++i)
+      {
+        m_drawing_contexts[i]->color().render(*back_renderer, Canvas::BELOW_LIGHTMAP);
+      }
+      m_drawing_contexts[last_ctx]->color().render(*back_renderer, Canvas::BELOW_LIGHTMAP, *last_layer);
+
+      back_renderer->end_draw();
+
+      ++s_back_buffer_frames;
+    }
   }
+  ++s_frames;
 
   // Compose the screen.
   {
@@ -134,13 +262,21 @@ Compositor::render()
     renderer.end_draw();
   }
 
-  // Clean up.
+  // Clean up, keeping the contexts and the request memory for the next frame.
   for (auto& ctx : m_drawing_contexts)
   {
+    ctx->light().take_pixels(m_pixels);
+    ctx->color().take_pixels(m_pixels);
     ctx->clear();
+    m_unused_contexts.push_back(std::move(ctx));
   }
+  m_drawing_contexts.clear();
+
+  for (const auto& [filename, verbose] : m_captures)
+    m_video_system.capture_frame(filename, verbose);
+  m_captures.clear();
+
   m_video_system.flip();
 
-  obstack_free(&m_obst, nullptr);
-  obstack_init(&m_obst);
+  reset_arena();
 }
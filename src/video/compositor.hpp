@@ -16,13 +16,19 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <memory>
+#include <string>
+#include <utility>
+#include <stdint.h>
 
 #include "util/obstackpp.hpp"
+#include "video/color.hpp"
 
 class DrawingContext;
 class Rect;
+class Renderer;
 class VideoSystem;
 
 class Compositor final
@@ -31,28 +37,76 @@ public:
   /** Debug flag to disable lighting, used in the editor */
   static bool s_render_lighting;
 
+  /** Number of frames rendered, and of those that needed the back
+      buffer for displacement textures */
+  static std::atomic<uint32_t> s_frames;
+  static std::atomic<uint32_t> s_back_buffer_frames;
+
 public:
-  Compositor(VideoSystem& video_system, float time_offset);
+  Compositor(VideoSystem& video_system);
   ~Compositor();
 
+  /** Starts recording a new frame. The drawing contexts, their request
+      arrays and the request memory of the previous frames are reused. */
+  void begin_frame(float time_offset);
+
   void render();
 
+  /** Hands the pixels read while rendering to the objects that requested
+      them, see Canvas::get_pixel(). Called on the main thread once the
+      frame has been rendered, as the RenderThread must not write them. */
+  void publish_pixels();
+
+  /** Captures the frame to the given file once it has been rendered,
+      see VideoSystem::capture_frame(). A frame may be captured to
+      several files. */
+  void add_capture(const std::string& filename, bool verbose = true);
+
   /** Create a DrawingContext, if overlay is true the context will not
       feature light rendering. This is required for contexts that
       overlap with other context (e.g. the HUD in ScreenManager) as
       otherwise their lighting would get messed up. */
   DrawingContext& make_context(bool overlay = false);
 
+  /** Bytes of drawing requests recorded in the last rendered frame, and
+      the size of the memory holding them */
+  inline size_t get_arena_used() const { return m_arena_used; }
+  inline size_t get_arena_capacity() const { return m_arena_capacity; }
+
+private:
+  /** Releases the drawing requests, keeping the memory that held them */
+  void reset_arena();
+
+  /** Whether the lightmap holds what this frame would draw into it, so
+      that it can be reused as is. Lights that didn't move on screen and
+      an unchanged ambient light give the same lightmap. */
+  bool is_lightmap_current(Renderer& lightmap) const;
+
 private:
   VideoSystem& m_video_system;
 
   /* obstack holding the memory of the drawing requests */
   obstack m_obst;
 
+  /** Start of the first chunk of m_obst, rewinding to it keeps the chunk */
+  void* m_obst_base;
+
+  /** Contexts of the current frame, and the ones of previous frames
+      which are available for reuse */
   std::vector<std::unique_ptr<DrawingContext> > m_drawing_contexts;
+  std::vector<std::unique_ptr<DrawingContext> > m_unused_contexts;
 
   float m_time_offset;
 
+  /** Files the frame is captured to, and whether to report success */
+  std::vector<std::pair<std::string, bool>> m_captures;
+
+  /** Pixels read by the last render(), until publish_pixels() */
+  std::vector<std::pair<std::shared_ptr<Color>, Color>> m_pixels;
+
+  size_t m_arena_used;
+  size_t m_arena_capacity;
+
 private:
   Compositor(const Compositor&) = delete;
   Compositor& operator=(const Compositor&) = delete;
@@ -50,6 +50,18 @@ DrawingContext::clear()
   m_colormap_canvas.clear();
 }
 
+void
+DrawingContext::reset(bool overlay, float time_offset)
+{
+  clear();
+
+  m_overlay = overlay;
+  m_ambient_color = Color::WHITE;
+  m_transform_stack.clear();
+  m_transform_stack.emplace_back(m_video_system.get_viewport());
+  m_time_offset = time_offset;
+}
+
 Rectf
 DrawingContext::get_cliprect() const
 {
@@ -97,6 +97,9 @@ public:
 
   void clear();
 
+  /** Prepares a context of a previous frame for reuse */
+  void reset(bool overlay, float time_offset);
+
   inline void set_viewport(const Rect& viewport) { transform().viewport = viewport; }
   inline const Rect& get_viewport() const { return transform().viewport; }
 
@@ -16,8 +16,10 @@
 
 #pragma once
 
+#include <array>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "math/rectf.hpp"
 #include "math/sizef.hpp"
@@ -140,16 +142,36 @@ struct LineRequest : public DrawingRequest
 {
   LineRequest(const DrawingTransform& transform) :
     DrawingRequest(transform),
-    pos(0.0f, 0.0f),
-    dest_pos(0.0f, 0.0f),
+    line(),
+    lines(),
+    offset(0.0f, 0.0f),
+    scale(1.0f),
     color()
   {}
 
   RequestType get_type() const override { return RequestType::LINE; }
 
-  Vector pos;
-  Vector dest_pos;
+  inline size_t get_point_count() const { return lines ? lines->size() : line.size(); }
+
+  /** Returns the i-th point, in screen coordinates */
+  inline Vector get_point(size_t i) const { return ((lines ? (*lines)[i] : line[i]) + offset) * scale; }
+
+  /** A single line, used if 'lines' is not set */
+  std::array<Vector, 2> line;
+
+  /** Start and end point of each line, so that many lines of the same
+      color can be drawn with a single request. They are shared with the
+      caller, which may keep them across frames, so they are transformed
+      only while painting: a point p is drawn at (p + offset) * scale. */
+  std::shared_ptr<const std::vector<Vector>> lines;
+  Vector offset;
+  float scale;
+
   Color color;
+
+private:
+  LineRequest(const LineRequest&) = delete;
+  LineRequest& operator=(const LineRequest&) = delete;
 };
 
 struct TriangleRequest : public DrawingRequest
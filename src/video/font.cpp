@@ -17,6 +17,29 @@
 
 #include "video/font.hpp"
 
+#include <functional>
+
+namespace {
+
+/** Texts are laid out again once this many of them are cached */
+const size_t MAX_LAYOUT_CACHE_SIZE = 256;
+
+size_t next_char(const std::string& text, size_t pos)
+{
+  ++pos;
+  // Skip "continuation" bytes in the form 10xxxxxx.
+  while (pos < text.size() && (text[pos] & 0xC0) == 0x80)
+    ++pos;
+  return pos;
+}
+
+} // namespace
+
+Font::Font() :
+  m_layout_cache()
+{
+}
+
 std::string
 Font::wrap_to_chars(const std::string& s, int line_length, std::string* overflow)
 {
@@ -38,3 +61,80 @@ Font::wrap_to_chars(const std::string& s, int line_length, std::string* overflow
   if (overflow) *overflow = "";
   return s;
 }
+
+std::string
+Font::wrap_to_width(const std::string& text, float width, std::string* overflow)
+{
+  size_t next;
+  const size_t end = break_line(text, 0, width, next);
+
+  if (overflow) *overflow = text.substr(next);
+  return text.substr(0, end);
+}
+
+const std::vector<std::string>&
+Font::wrap_to_lines(const std::string& text, float width)
+{
+  const size_t hash = std::hash<std::string>()(text) ^ (std::hash<float>()(width) << 1);
+
+  auto it = m_layout_cache.find(hash);
+  if (it != m_layout_cache.end() && it->second.width == width && it->second.text == text)
+    return it->second.lines;
+
+  if (it == m_layout_cache.end() && m_layout_cache.size() >= MAX_LAYOUT_CACHE_SIZE)
+    m_layout_cache.clear();
+
+  LayoutCacheEntry& entry = m_layout_cache[hash];
+  entry.width = width;
+  entry.text = text;
+  entry.lines.clear();
+
+  size_t begin = 0;
+  do {
+    size_t next;
+    const size_t end = break_line(text, begin, width, next);
+    entry.lines.push_back(text.substr(begin, end - begin));
+    begin = next;
+  } while (begin < text.size());
+
+  return entry.lines;
+}
+
+size_t
+Font::break_line(const std::string& text, size_t begin, float width, size_t& next) const
+{
+  // Newlines are kept in the text, the line only has to fit in between them.
+  size_t segment_begin = begin;
+  while (true)
+  {
+    size_t segment_end = text.find('\n', segment_begin);
+    if (segment_end == std::string::npos)
+      segment_end = text.size();
+
+    const size_t fit = segment_begin + get_fitting_length(text.substr(segment_begin, segment_end - segment_begin), width);
+    if (fit == segment_end)
+    {
+      if (segment_end == text.size())
+      {
+        next = text.size();
+        return text.size();
+      }
+
+      segment_begin = segment_end + 1;
+      continue;
+    }
+
+    // Break at the last whitespace character up to which the text fits.
+    const size_t space = text.rfind(' ', fit);
+    if (space != std::string::npos && space >= begin)
+    {
+      next = space + 1;
+      return space;
+    }
+
+    // Hard-wrap at width, but keep at least one character on each line.
+    const size_t end = (fit == begin) ? next_char(text, begin) : fit;
+    next = end;
+    return end;
+  }
+}
@@ -18,6 +18,8 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "math/rectf.hpp"
 #include "math/vector.hpp"
@@ -42,6 +44,7 @@ public:
   static std::string wrap_to_chars(const std::string& text, int max_chars, std::string* overflow);
 
 public:
+  Font();
   virtual ~Font() {}
 
   virtual float get_height() const = 0;
@@ -49,8 +52,44 @@ public:
   virtual float get_text_width(const std::string& text) const = 0;
   virtual float get_text_height(const std::string& text) const = 0;
 
-  virtual std::string wrap_to_width(const std::string& text, float width, std::string* overflow) = 0;
+  /**
+   * returns the given string, truncated (preferably at whitespace) to be at most "width" pixels wide
+   */
+  std::string wrap_to_width(const std::string& text, float width, std::string* overflow);
+
+  /**
+   * returns the lines that repeatedly calling wrap_to_width() on the
+   * overflow would give, laid out in a single pass. Results are cached,
+   * the reference is valid until the next call.
+   */
+  const std::vector<std::string>& wrap_to_lines(const std::string& text, float width);
 
   virtual Rectf draw_text(Canvas& canvas, const std::string& text,
                           const Vector& pos, FontAlignment alignment, int layer, const Color& color) = 0;
+
+protected:
+  /** Returns the number of bytes at the start of the line, which
+      contains no newlines, that fit into the given width. Measures each
+      character only once and never cuts a character in half. */
+  virtual size_t get_fitting_length(const std::string& line, float width) const = 0;
+
+private:
+  /** Returns the end of the line starting at begin, and the start of
+      the line following it in next */
+  size_t break_line(const std::string& text, size_t begin, float width, size_t& next) const;
+
+private:
+  struct LayoutCacheEntry
+  {
+    float width;
+    std::string text;
+    std::vector<std::string> lines;
+  };
+
+  /** Laid out texts, keyed by the hash of the width and the text */
+  std::unordered_map<size_t, LayoutCacheEntry> m_layout_cache;
+
+private:
+  Font(const Font&) = delete;
+  Font& operator=(const Font&) = delete;
 };
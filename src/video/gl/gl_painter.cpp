@@ -399,39 +399,57 @@ GLPainter::draw_line(const LineRequest& request)
   assert_gl();
 
   Vector viewport_scale = m_video_system.get_viewport().get_scale();
-  const float& x1 = request.pos.x;
-  const float& y1 = request.pos.y;
-  const float& x2 = request.dest_pos.x;
-  const float& y2 = request.dest_pos.y;
 
   // OpenGL3.3 doesn't have GL_LINES anymore, so instead we transform
-  // the line into a quad and draw it as triangle strip.
-  float x_step = (y2 - y1);
-  float y_step = -(x2 - x1);
+  // each line into a quad, made of two triangles.
+  m_vertices.clear();
+  m_vertices.reserve(request.get_point_count() / 2 * 12);
+  for (size_t i = 0; i + 1 < request.get_point_count(); i += 2)
+  {
+    const Vector p1 = request.get_point(i);
+    const Vector p2 = request.get_point(i + 1);
+    const float& x1 = p1.x;
+    const float& y1 = p1.y;
+    const float& x2 = p2.x;
+    const float& y2 = p2.y;
 
-  const float step_norm = sqrtf(x_step * x_step + y_step * y_step);
-  x_step /= step_norm * viewport_scale.x;
-  y_step /= step_norm * viewport_scale.y;
+    float x_step = (y2 - y1);
+    float y_step = -(x2 - x1);
 
-  x_step *= 0.5f;
-  y_step *= 0.5f;
+    const float step_norm = sqrtf(x_step * x_step + y_step * y_step);
+    if (step_norm == 0.0f)
+      continue;
 
-  const float vertices[] = {
-    (x1 - x_step), (y1 - y_step),
-    (x2 - x_step), (y2 - y_step),
-    (x1 + x_step), (y1 + y_step),
-    (x2 + x_step), (y2 + y_step),
-  };
+    x_step /= step_norm * viewport_scale.x;
+    y_step /= step_norm * viewport_scale.y;
+
+    x_step *= 0.5f;
+    y_step *= 0.5f;
+
+    const float vertices[] = {
+      (x1 - x_step), (y1 - y_step),
+      (x2 - x_step), (y2 - y_step),
+      (x1 + x_step), (y1 + y_step),
+
+      (x1 + x_step), (y1 + y_step),
+      (x2 - x_step), (y2 - y_step),
+      (x2 + x_step), (y2 + y_step),
+    };
+    m_vertices.insert(m_vertices.end(), vertices, vertices + 12);
+  }
+
+  if (m_vertices.empty())
+    return;
 
   GLContext& context = m_video_system.get_context();
 
   context.blend_func(sfactor(request.blend), dfactor(request.blend));
   context.bind_no_texture();
-  context.set_positions(vertices, sizeof(vertices));
+  context.set_positions(m_vertices.data(), sizeof(float) * m_vertices.size());
   context.set_texcoord(0.0f, 0.0f);
   context.set_color(request.color);
 
-  context.draw_arrays(GL_TRIANGLE_STRIP, 0, 4);
+  context.draw_arrays(GL_TRIANGLES, 0, static_cast<GLsizei>(m_vertices.size() / 2));
 
   assert_gl();
 }
@@ -471,7 +489,7 @@ GLPainter::clear(const Color& color)
   assert_gl();
 }
 
-void
+Color
 GLPainter::get_pixel(const GetPixelRequest& request) const
 {
   assert_gl();
@@ -493,7 +511,7 @@ GLPainter::get_pixel(const GetPixelRequest& request) const
   GLPixelRequest pixel_request(1, 1);
   pixel_request.request(static_cast<int>(x), static_cast<int>(y));
 
-  *(request.color_ptr) = pixel_request.get_color();
+  const Color color = pixel_request.get_color();
 
 #else
   float pixels[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
@@ -502,10 +520,12 @@ GLPainter::get_pixel(const GetPixelRequest& request) const
   glReadPixels(static_cast<GLint>(x), static_cast<GLint>(y),
                1, 1, GL_RGB, GL_FLOAT, pixels);
 
-  *(request.color_ptr) = Color(pixels[0], pixels[1], pixels[2]);
+  const Color color(pixels[0], pixels[1], pixels[2]);
 #endif
 
   assert_gl();
+
+  return color;
 }
 
 void
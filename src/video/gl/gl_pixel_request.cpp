@@ -18,8 +18,11 @@
 
 #include <iostream>
 
+#include <string.h>
+
 #include "util/log.hpp"
 #include "video/glutil.hpp"
+#include "video/sdl_surface.hpp"
 
 #ifndef USE_OPENGLES2
 
@@ -42,6 +45,8 @@ GLPixelRequest::GLPixelRequest(int width, int height) :
 
 GLPixelRequest::~GLPixelRequest()
 {
+  if (m_sync)
+    glDeleteSync(m_sync);
   glDeleteBuffers(1, &m_buffer);
 }
 
@@ -50,7 +55,11 @@ GLPixelRequest::request(int x, int y)
 {
   assert_gl();
 
+  if (m_sync)
+    glDeleteSync(m_sync);
+
   glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
   glReadPixels(x, y, m_width, m_height, GL_RGB, GL_UNSIGNED_BYTE,
                reinterpret_cast<GLvoid*>(m_offset));
   m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, GL_NONE_BIT);
@@ -91,6 +100,22 @@ GLPixelRequest::is_ready() const
   assert_gl();
 }
 
+void
+GLPixelRequest::wait() const
+{
+  // Flush once, so that the fence is guaranteed to be signaled eventually.
+  GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+  while (true)
+  {
+    const GLenum ret = glClientWaitSync(m_sync, flags, 1000000);
+    if (ret != GL_TIMEOUT_EXPIRED)
+      break;
+    flags = GL_NONE_BIT;
+  }
+
+  assert_gl();
+}
+
 void
 GLPixelRequest::get(void* buffer, size_t length) const
 {
@@ -111,4 +136,36 @@ GLPixelRequest::get_color() const
   return Color::from_rgb888(data[0], data[1], data[2]);
 }
 
+SDLSurfacePtr
+GLPixelRequest::get_surface() const
+{
+  assert_gl();
+
+  SDLSurfacePtr surface = SDLSurface::create_rgb(m_width, m_height);
+  const size_t row_length = 3 * static_cast<size_t>(m_width);
+
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, m_buffer);
+  const char* pixels = static_cast<const char*>(glMapBufferRange(GL_PIXEL_PACK_BUFFER, m_offset,
+                                                                 row_length * m_height, GL_MAP_READ_BIT));
+  if (pixels)
+  {
+    // OpenGL stores the bottom row first.
+    SDL_LockSurface(surface.get());
+    for (int i = 0; i < m_height; ++i)
+    {
+      const char* src = pixels + row_length * (m_height - i - 1);
+      char* dst = static_cast<char*>(surface->pixels) + i * surface->pitch;
+      memcpy(dst, src, row_length);
+    }
+    SDL_UnlockSurface(surface.get());
+
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+  }
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  assert_gl();
+
+  return surface;
+}
+
 #endif
@@ -20,6 +20,7 @@
 
 #include "video/color.hpp"
 #include "video/gl.hpp"
+#include "video/sdl_surface_ptr.hpp"
 
 #ifndef USE_OPENGLES2
 
@@ -31,8 +32,18 @@ public:
 
   void request(int x, int y);
   bool is_ready() const;
+
+  /** Blocks until the requested pixels have arrived */
+  void wait() const;
+
   Color get_color() const;
 
+  /** Returns the requested pixels with the top row first */
+  SDLSurfacePtr get_surface() const;
+
+  inline int get_width() const { return m_width; }
+  inline int get_height() const { return m_height; }
+
 private:
   void get(void* buffer, size_t length) const;
 
@@ -19,10 +19,13 @@
 #include <assert.h>
 
 #include "video/glutil.hpp"
+#include "video/render_thread.hpp"
 #include "video/sampler.hpp"
 #include "video/sdl_surface.hpp"
 
-GLTexture::GLTexture(int width, int height, std::optional<Color> fill_color) :
+GLTexture::GLTexture(int width, int height, std::optional<Color> fill_color,
+                     const Sampler& sampler) :
+  Texture(sampler),
   m_handle(),
   m_texture_width(),
   m_texture_height(),
@@ -98,60 +101,77 @@ GLTexture::reload(const SDL_Surface& image)
   m_image_width  = image.w;
   m_image_height = image.h;
 
-  SDLSurfacePtr convert = SDLSurface::create_rgba(m_texture_width, m_texture_height);
-
-  SDL_SetSurfaceBlendMode(const_cast<SDL_Surface*>(&image), SDL_BLENDMODE_NONE);
-  SDL_BlitSurface(const_cast<SDL_Surface*>(&image), nullptr, convert.get(), nullptr);
+  // Images that are already 32-bit RGBA and need no padding, like the
+  // ones decoded by TextureManager::preload(), are uploaded as they are.
+  const bool direct = image.format->format == SDL_PIXELFORMAT_RGBA32 &&
+                      !SDL_MUSTLOCK(&image) &&
+                      m_image_width == m_texture_width &&
+                      m_image_height == m_texture_height
+#if !defined(GL_UNPACK_ROW_LENGTH)
+                      && image.pitch == image.w * 4
+#endif
+                      ;
 
-  // Fill the remaining pixels of 'convert' with repeated copies of
-  // 'image' to minimize OpenGL blending artifacts at the borders.
-  if (m_image_width != m_texture_width || m_image_height != m_texture_height)
+  SDLSurfacePtr convert;
+  if (!direct)
   {
-    if (SDL_MUSTLOCK(convert)) {
-      SDL_LockSurface(convert.get());
-    }
+    convert = SDLSurface::create_rgba(m_texture_width, m_texture_height);
+
+    SDL_SetSurfaceBlendMode(const_cast<SDL_Surface*>(&image), SDL_BLENDMODE_NONE);
+    SDL_BlitSurface(const_cast<SDL_Surface*>(&image), nullptr, convert.get(), nullptr);
 
-    if (m_image_width != m_texture_width) {
-      SDL_Rect srcrect{m_image_width - 1, 0, 1, m_image_height};
-      for (int x = m_image_width; x < m_texture_width; ++x) {
-        SDL_Rect dstrect{x, 0, 1, m_image_height};
-        SDL_BlitSurface(const_cast<SDL_Surface*>(&image), &srcrect, convert.get(), &dstrect);
+    // Fill the remaining pixels of 'convert' with repeated copies of
+    // 'image' to minimize OpenGL blending artifacts at the borders.
+    if (m_image_width != m_texture_width || m_image_height != m_texture_height)
+    {
+      if (SDL_MUSTLOCK(convert)) {
+        SDL_LockSurface(convert.get());
       }
-    }
 
-    if (m_image_height != m_texture_height) {
-      SDL_Rect srcrect{0, m_image_height - 1, m_image_width, 1};
-      for (int y = m_image_height; y < m_texture_height; ++y) {
-        SDL_Rect dstrect{0, y, m_image_width, 1};
-        SDL_BlitSurface(const_cast<SDL_Surface*>(&image), &srcrect, convert.get(), &dstrect);
+      if (m_image_width != m_texture_width) {
+        SDL_Rect srcrect{m_image_width - 1, 0, 1, m_image_height};
+        for (int x = m_image_width; x < m_texture_width; ++x) {
+          SDL_Rect dstrect{x, 0, 1, m_image_height};
+          SDL_BlitSurface(const_cast<SDL_Surface*>(&image), &srcrect, convert.get(), &dstrect);
+        }
       }
-    }
 
-    if (m_image_width != m_texture_width && m_image_height != m_texture_height)
-    {
-      const int bpp = convert->format->BytesPerPixel;
-      const int x = m_image_width - 1;
-      const int y = m_image_height - 1;
-      Uint32 color = 0;
-      memcpy(&color, static_cast<uint8_t*>(convert->pixels) + y * convert->pitch + x * bpp, bpp);
-      SDL_Rect dstrect{m_image_width, m_image_height, m_texture_width, m_texture_height};
-      SDL_FillRect(convert.get(), &dstrect, color);
-    }
+      if (m_image_height != m_texture_height) {
+        SDL_Rect srcrect{0, m_image_height - 1, m_image_width, 1};
+        for (int y = m_image_height; y < m_texture_height; ++y) {
+          SDL_Rect dstrect{0, y, m_image_width, 1};
+          SDL_BlitSurface(const_cast<SDL_Surface*>(&image), &srcrect, convert.get(), &dstrect);
+        }
+      }
 
-    if (SDL_MUSTLOCK(convert)) {
-      SDL_UnlockSurface(convert.get());
+      if (m_image_width != m_texture_width && m_image_height != m_texture_height)
+      {
+        const int bpp = convert->format->BytesPerPixel;
+        const int x = m_image_width - 1;
+        const int y = m_image_height - 1;
+        Uint32 color = 0;
+        memcpy(&color, static_cast<uint8_t*>(convert->pixels) + y * convert->pitch + x * bpp, bpp);
+        SDL_Rect dstrect{m_image_width, m_image_height, m_texture_width, m_texture_height};
+        SDL_FillRect(convert.get(), &dstrect, color);
+      }
+
+      if (SDL_MUSTLOCK(convert)) {
+        SDL_UnlockSurface(convert.get());
+      }
     }
   }
 
+  const SDL_Surface& pixels = convert ? *convert : image;
+
   assert_gl();
 
   glGenTextures(1, &m_handle);
 
   try {
     GLenum sdl_format;
-    if (convert->format->BytesPerPixel == 3) {
+    if (pixels.format->BytesPerPixel == 3) {
       sdl_format = GL_RGB;
-    } else if (convert->format->BytesPerPixel == 4) {
+    } else if (pixels.format->BytesPerPixel == 4) {
       sdl_format = GL_RGBA;
     } else {
       sdl_format = GL_RGBA; // NOLINT.
@@ -161,28 +181,28 @@ GLTexture::reload(const SDL_Surface& image)
     glBindTexture(GL_TEXTURE_2D, m_handle);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 #if defined(GL_UNPACK_ROW_LENGTH)
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, convert->pitch/convert->format->BytesPerPixel);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, pixels.pitch/pixels.format->BytesPerPixel);
 #else
     /* OpenGL ES doesn't support UNPACK_ROW_LENGTH, let's hope SDL didn't add
      * padding bytes, otherwise we need some extra code here... */
-    assert(convert->pitch == static_cast<int>(m_texture_width * convert->format->BytesPerPixel));
+    assert(pixels.pitch == static_cast<int>(m_texture_width * pixels.format->BytesPerPixel));
 #endif
 
-    if (SDL_MUSTLOCK(convert)) {
-      SDL_LockSurface(convert.get());
+    if (SDL_MUSTLOCK(&pixels)) {
+      SDL_LockSurface(const_cast<SDL_Surface*>(&pixels));
     }
 
     glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(GL_RGBA),
                  m_texture_width, m_texture_height, 0, sdl_format,
-                 GL_UNSIGNED_BYTE, convert->pixels);
+                 GL_UNSIGNED_BYTE, pixels.pixels);
 
     // Disable the use of mipmaps for the texture.
 #if 0
     glGenerateMipmap(GL_TEXTURE_2D);
 #endif
 
-    if (SDL_MUSTLOCK(convert.get())) {
-      SDL_UnlockSurface(convert.get());
+    if (SDL_MUSTLOCK(&pixels)) {
+      SDL_UnlockSurface(const_cast<SDL_Surface*>(&pixels));
     }
 
     assert_gl();
@@ -198,7 +218,69 @@ GLTexture::reload(const SDL_Surface& image)
 
 GLTexture::~GLTexture()
 {
-  glDeleteTextures(1, &m_handle);
+  // The main thread may not have a context while there is a RenderThread.
+  if (auto* render_thread = RenderThread::current())
+    render_thread->release([handle = m_handle] { glDeleteTextures(1, &handle); });
+  else
+    glDeleteTextures(1, &m_handle);
+}
+
+void
+GLTexture::upload(const SDL_Surface& image, GLuint pixel_buffer)
+{
+  assert(image.format->format == SDL_PIXELFORMAT_RGBA32 && !SDL_MUSTLOCK(&image));
+  assert(image.w == m_texture_width && image.h == m_texture_height);
+
+  assert_gl();
+
+  glBindTexture(GL_TEXTURE_2D, m_handle);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+#ifndef USE_OPENGLES2
+  if (pixel_buffer)
+  {
+    const size_t row_length = 4 * static_cast<size_t>(image.w);
+    const GLsizeiptr size = static_cast<GLsizeiptr>(row_length * image.h);
+
+    // Respecifying the storage orphans the one of the previous upload,
+    // so that mapping doesn't wait for that transfer to finish.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixel_buffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    char* pixels = static_cast<char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    if (pixels)
+    {
+      for (int y = 0; y < image.h; ++y)
+      {
+        memcpy(pixels + y * row_length, static_cast<const char*>(image.pixels) + y * image.pitch, row_length);
+      }
+
+      if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+      {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.w, image.h,
+                        GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        assert_gl();
+        return;
+      }
+    }
+
+    // The buffer couldn't be written, upload from memory instead.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+#endif
+
+#if defined(GL_UNPACK_ROW_LENGTH)
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, image.pitch / 4);
+#else
+  assert(image.pitch == image.w * 4);
+#endif
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, image.w, image.h,
+                  GL_RGBA, GL_UNSIGNED_BYTE, image.pixels);
+
+  assert_gl();
 }
 
 void
@@ -29,12 +29,20 @@
 class GLTexture final : public Texture
 {
 public:
-  GLTexture(int width, int height, std::optional<Color> fill_color = std::nullopt);
+  GLTexture(int width, int height, std::optional<Color> fill_color = std::nullopt,
+            const Sampler& sampler = Sampler());
   GLTexture(const SDL_Surface& image, const Sampler& sampler);
   ~GLTexture() override;
 
   virtual void reload(const SDL_Surface& image) override;
 
+  /** Replaces the pixels of the texture with \a image, which must be
+      32-bit RGBA and as large as the texture. Unlike reload(), this
+      keeps the handle. If \a pixel_buffer isn't 0, the pixels are
+      copied into that buffer object and transferred from there
+      asynchronously. */
+  void upload(const SDL_Surface& image, GLuint pixel_buffer);
+
   virtual int get_texture_width() const override { return m_texture_width; }
   virtual int get_texture_height() const override { return m_texture_height; }
 
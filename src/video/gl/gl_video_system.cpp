@@ -30,6 +30,7 @@
 #include "video/gl/gl_texture_renderer.hpp"
 #include "video/gl/gl_vertex_arrays.hpp"
 #include "video/glutil.hpp"
+#include "video/render_thread.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/texture_manager.hpp"
 
@@ -71,6 +72,9 @@
 static bool WORST_FUCKING_HACK_IN_THIS_CODEBASE = false;
 // Resize is ignored on fullscreen, so we're gonna flicker it
 static bool HACK_FULLSCREEN_FLIPPED = false;
+// Set once the first frame has been flipped, possibly on the RenderThread.
+// Read by the main thread only while the RenderThread is idle.
+static bool HACK_FIRST_FLIP_DONE = false;
 #endif
 
 GLVideoSystem::GLVideoSystem(bool use_opengl33core, bool auto_opengl_version) :
@@ -81,6 +85,14 @@ GLVideoSystem::GLVideoSystem(bool use_opengl33core, bool auto_opengl_version) :
   m_back_renderer(),
   m_context(),
   m_glcontext(),
+  m_loader_glcontext(),
+  m_main_thread_has_context(true),
+  m_textures_uploaded(false),
+#ifndef USE_OPENGLES2
+  m_captures(),
+  m_next_capture(0),
+  m_upload_buffer(0),
+#endif
   m_viewport()
 {
   create_gl_window();
@@ -139,12 +151,26 @@ GLVideoSystem::GLVideoSystem(bool use_opengl33core, bool auto_opengl_version) :
 
 GLVideoSystem::~GLVideoSystem()
 {
+#ifndef USE_OPENGLES2
+  // Don't lose the frames captured last.
+  for (size_t i = 0; i < m_captures.size(); ++i)
+  {
+    if (m_captures[i].age >= 0)
+      finish_capture(i);
+    m_captures[i].request.reset();
+  }
+
+  if (m_upload_buffer)
+    glDeleteBuffers(1, &m_upload_buffer);
+#endif
+
   SDL_GL_DeleteContext(m_glcontext);
 }
 
 std::string
 GLVideoSystem::get_name() const
 {
+  acquire_main_thread_context();
   assert_gl();
 
   std::ostringstream out;
@@ -298,6 +324,8 @@ GLVideoSystem::create_gl_context()
 void
 GLVideoSystem::apply_config()
 {
+  acquire_main_thread_context();
+
   apply_video_mode();
 
   Size target_size = g_config->use_fullscreen ?
@@ -347,17 +375,69 @@ GLVideoSystem::get_back_renderer() const
 TexturePtr
 GLVideoSystem::new_texture(const SDL_Surface& image, const Sampler& sampler)
 {
-  return TexturePtr(new GLTexture(image, sampler));
+  m_textures_uploaded = true;
+  return TexturePtr(new GLTexture(image, sampler), &RenderThread::delete_texture);
+}
+
+TexturePtr
+GLVideoSystem::new_deferred_texture(int width, int height, const Sampler& sampler)
+{
+  // Padding the image to a power of two is left to GLTexture::reload().
+  if (gl_needs_power_of_two())
+    return TexturePtr();
+
+  m_textures_uploaded = true;
+  return TexturePtr(new GLTexture(width, height, std::nullopt, sampler), &RenderThread::delete_texture);
+}
+
+void
+GLVideoSystem::upload_texture(Texture& texture, const SDL_Surface& image)
+{
+  GLuint pixel_buffer = 0;
+#ifndef USE_OPENGLES2
+  if (use_pixel_buffer_upload())
+  {
+    if (!m_upload_buffer)
+      glGenBuffers(1, &m_upload_buffer);
+    pixel_buffer = m_upload_buffer;
+  }
+#endif
+
+  m_textures_uploaded = true;
+  static_cast<GLTexture&>(texture).upload(image, pixel_buffer);
 }
 
 void
 GLVideoSystem::flip()
 {
+  // With a RenderThread, this is called from there, see Compositor::render().
   assert_gl();
   SDL_GL_SwapWindow(m_sdl_window.get());
 
+#ifndef USE_OPENGLES2
+  // Readbacks requested in the previous frame have had a whole frame to
+  // complete, so mapping them now rarely stalls.
+  for (size_t i = 0; i < m_captures.size(); ++i)
+  {
+    if (m_captures[i].age >= 0 && ++m_captures[i].age > 1)
+      finish_capture(i);
+  }
+#endif
+
+#ifdef WIN32
+  // The window and g_config belong to the main thread. With a
+  // RenderThread, this is done in render_thread_submit() instead.
+  HACK_FIRST_FLIP_DONE = true;
+  if (!RenderThread::current())
+    undo_resize_hack();
+#endif
+}
+
 #ifdef WIN32
-  if (WORST_FUCKING_HACK_IN_THIS_CODEBASE)
+void
+GLVideoSystem::undo_resize_hack()
+{
+  if (WORST_FUCKING_HACK_IN_THIS_CODEBASE && HACK_FIRST_FLIP_DONE)
   {
     SDL_SetWindowSize(m_sdl_window.get(), get_window_size().width - 1, get_window_size().height);
     if (HACK_FULLSCREEN_FLIPPED)
@@ -365,12 +445,14 @@ GLVideoSystem::flip()
     apply_video_mode();
     WORST_FUCKING_HACK_IN_THIS_CODEBASE = false;
   }
-#endif
 }
+#endif
 
 void
 GLVideoSystem::set_vsync(int mode)
 {
+  acquire_main_thread_context();
+
   if (SDL_GL_SetSwapInterval(mode) < 0)
   {
     log_warning << "Setting vsync mode to " << mode << " failed: " << SDL_GetError() << std::endl;
@@ -400,11 +482,88 @@ GLVideoSystem::set_vsync(int mode)
 int
 GLVideoSystem::get_vsync() const
 {
+  acquire_main_thread_context();
   return SDL_GL_GetSwapInterval();
 }
 
 SDLSurfacePtr
 GLVideoSystem::make_screenshot()
+{
+  acquire_main_thread_context();
+  return read_viewport();
+}
+
+void
+GLVideoSystem::capture_frame(const std::string& filename, bool verbose)
+{
+  // Called while rendering, with m_glcontext current on this thread.
+#ifndef USE_OPENGLES2
+  if (use_async_capture())
+  {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    const size_t index = m_next_capture;
+    m_next_capture = (m_next_capture + 1) % m_captures.size();
+
+    FrameCapture& capture = m_captures[index];
+    if (capture.age >= 0)
+      finish_capture(index);
+
+    if (!capture.request ||
+        capture.request->get_width() != viewport[2] ||
+        capture.request->get_height() != viewport[3])
+    {
+      capture.request = std::make_unique<GLPixelRequest>(viewport[2], viewport[3]);
+    }
+
+    capture.request->request(viewport[0], viewport[1]);
+    capture.filename = filename;
+    capture.verbose = verbose;
+    capture.age = 0;
+    return;
+  }
+#endif
+
+  save_screenshot(read_viewport(), filename, verbose);
+}
+
+#ifndef USE_OPENGLES2
+bool
+GLVideoSystem::use_async_capture() const
+{
+  // glFenceSync() crashes some drivers used with the OpenGL 2.0 context,
+  // see GLPainter::get_pixel(), and WebGL can't map buffers.
+#ifdef __EMSCRIPTEN__
+  return false;
+#else
+  return m_use_opengl33core;
+#endif
+}
+
+bool
+GLVideoSystem::use_pixel_buffer_upload() const
+{
+  // Pixel buffer objects need OpenGL 2.1, and WebGL can't map buffers.
+#ifdef __EMSCRIPTEN__
+  return false;
+#else
+  return m_use_opengl33core;
+#endif
+}
+
+void
+GLVideoSystem::finish_capture(size_t index)
+{
+  FrameCapture& capture = m_captures[index];
+  capture.request->wait();
+  save_screenshot(capture.request->get_surface(), capture.filename, capture.verbose);
+  capture.age = -1;
+}
+#endif
+
+SDLSurfacePtr
+GLVideoSystem::read_viewport() const
 {
   assert_gl();
 
@@ -436,3 +595,94 @@ GLVideoSystem::make_screenshot()
 
   return surface;
 }
+
+bool
+GLVideoSystem::supports_render_thread() const
+{
+#ifdef __EMSCRIPTEN__
+  return false;
+#else
+  return true;
+#endif
+}
+
+void
+GLVideoSystem::render_thread_started()
+{
+  // Textures keep being created on the main thread while the render
+  // thread owns m_glcontext, in a second context sharing its objects.
+  // Creating the context makes it current on this thread.
+  SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 1);
+  m_loader_glcontext = SDL_GL_CreateContext(m_sdl_window.get());
+  SDL_GL_SetAttribute(SDL_GL_SHARE_WITH_CURRENT_CONTEXT, 0);
+
+  if (!m_loader_glcontext)
+  {
+    std::ostringstream msg;
+    msg << "Couldn't create shared OpenGL context: " << SDL_GetError();
+    throw std::runtime_error(msg.str());
+  }
+
+  m_main_thread_has_context = false;
+}
+
+void
+GLVideoSystem::render_thread_stopped()
+{
+  SDL_GL_MakeCurrent(m_sdl_window.get(), m_glcontext);
+  m_main_thread_has_context = true;
+
+  SDL_GL_DeleteContext(m_loader_glcontext);
+  m_loader_glcontext = nullptr;
+
+#ifdef WIN32
+  undo_resize_hack();
+#endif
+}
+
+void
+GLVideoSystem::render_thread_submit()
+{
+#ifdef WIN32
+  // The render thread is idle here, so it won't flip() concurrently.
+  undo_resize_hack();
+#endif
+
+  // Uploads of the main thread must be complete before the render
+  // thread uses the textures in its own context.
+  if (m_textures_uploaded.exchange(false))
+    glFinish();
+
+  if (m_main_thread_has_context)
+  {
+    SDL_GL_MakeCurrent(m_sdl_window.get(), m_loader_glcontext);
+    m_main_thread_has_context = false;
+  }
+}
+
+void
+GLVideoSystem::render_thread_begin_frame()
+{
+  SDL_GL_MakeCurrent(m_sdl_window.get(), m_glcontext);
+}
+
+void
+GLVideoSystem::render_thread_end_frame()
+{
+  // A context can only be current on one thread at a time, hand it back
+  // so that the main thread can take it when it needs to.
+  SDL_GL_MakeCurrent(m_sdl_window.get(), nullptr);
+}
+
+void
+GLVideoSystem::acquire_main_thread_context() const
+{
+  if (m_main_thread_has_context)
+    return;
+
+  if (auto* render_thread = RenderThread::current())
+    render_thread->wait_idle();
+
+  SDL_GL_MakeCurrent(m_sdl_window.get(), m_glcontext);
+  m_main_thread_has_context = true;
+}
@@ -16,10 +16,14 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <string>
 #include <SDL.h>
 
 #include "math/size.hpp"
+#include "video/gl/gl_pixel_request.hpp"
 #include "video/sdlbase_video_system.hpp"
 #include "video/viewport.hpp"
 
@@ -47,6 +51,8 @@ public:
   virtual Renderer& get_lightmap() const override;
 
   virtual TexturePtr new_texture(const SDL_Surface& image, const Sampler& sampler) override;
+  virtual TexturePtr new_deferred_texture(int width, int height, const Sampler& sampler) override;
+  virtual void upload_texture(Texture& texture, const SDL_Surface& image) override;
 
   virtual const Viewport& get_viewport() const override { return m_viewport; }
   virtual void apply_config() override;
@@ -56,6 +62,14 @@ public:
   virtual int get_vsync() const override;
 
   virtual SDLSurfacePtr make_screenshot() override;
+  virtual void capture_frame(const std::string& filename, bool verbose) override;
+
+  virtual bool supports_render_thread() const override;
+  virtual void render_thread_started() override;
+  virtual void render_thread_stopped() override;
+  virtual void render_thread_submit() override;
+  virtual void render_thread_begin_frame() override;
+  virtual void render_thread_end_frame() override;
 
   inline GLContext& get_context() const { return *m_context; }
 
@@ -63,6 +77,33 @@ private:
   void create_gl_window();
   void create_gl_context();
 
+#ifdef WIN32
+  /** Resizes the window back after the first flip(), see the comment
+      near the top of gl_video_system.cpp. Main thread only. */
+  void undo_resize_hack();
+#endif
+
+  /** Makes m_glcontext current on the main thread, waiting for the
+      RenderThread to finish its frame first, if there is one */
+  void acquire_main_thread_context() const;
+
+  /** Reads the pixels of the viewport from the current context */
+  SDLSurfacePtr read_viewport() const;
+
+#ifndef USE_OPENGLES2
+  /** Whether captured frames are read back asynchronously into pixel
+      buffer objects, instead of stalling until the frame is rendered */
+  bool use_async_capture() const;
+
+  /** Waits for the readback of the capture and hands it to the
+      ScreenshotWriter */
+  void finish_capture(size_t index);
+
+  /** Whether upload_texture() streams the pixels through a pixel buffer
+      object */
+  bool use_pixel_buffer_upload() const;
+#endif
+
 private:
   bool m_use_opengl33core;
   std::unique_ptr<TextureManager> m_texture_manager;
@@ -72,6 +113,35 @@ private:
   std::unique_ptr<GLContext> m_context;
 
   SDL_GLContext m_glcontext;
+
+  /** While a RenderThread owns m_glcontext, textures are created in
+      this context on the main thread, which shares its objects */
+  SDL_GLContext m_loader_glcontext;
+  mutable bool m_main_thread_has_context;
+  std::atomic<bool> m_textures_uploaded;
+
+#ifndef USE_OPENGLES2
+  /** Captured frames whose pixels are on their way from the GPU. The
+      readback is fenced and only mapped one frame later, when it has
+      most likely completed. */
+  struct FrameCapture final
+  {
+    std::unique_ptr<GLPixelRequest> request;
+    std::string filename;
+    bool verbose = true;
+
+    /** Number of flip()s since the readback was requested, -1 if none is
+        pending */
+    int age = -1;
+  };
+  std::array<FrameCapture, 2> m_captures;
+  size_t m_next_capture;
+
+  /** Buffer object upload_texture() streams pixels through, 0 until
+      the first upload */
+  GLuint m_upload_buffer;
+#endif
+
   Viewport m_viewport;
 
 private:
@@ -70,10 +70,11 @@ NullPainter::clear(const Color& color)
   log_info << "NullPainter::clear()" << std::endl;
 }
 
-void
+Color
 NullPainter::get_pixel(const GetPixelRequest& request) const
 {
   log_info << "NullPainter::get_pixel()" << std::endl;
+  return Color(0.0f, 0.0f, 0.0f);
 }
 
 void
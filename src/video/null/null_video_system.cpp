@@ -21,6 +21,7 @@
 #include "util/log.hpp"
 #include "video/null/null_renderer.hpp"
 #include "video/null/null_texture.hpp"
+#include "video/render_thread.hpp"
 #include "video/sdl_surface_ptr.hpp"
 #include "video/texture_manager.hpp"
 
@@ -59,7 +60,7 @@ NullVideoSystem::get_lightmap() const
 TexturePtr
 NullVideoSystem::new_texture(const SDL_Surface& image, const Sampler& sampler)
 {
-  return TexturePtr(new NullTexture(Size(image.w, image.h)));
+  return TexturePtr(new NullTexture(Size(image.w, image.h)), &RenderThread::delete_texture);
 }
 
 const Viewport&
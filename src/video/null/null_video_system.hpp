@@ -50,6 +50,11 @@ public:
   virtual void set_icon(const SDL_Surface& icon) override;
   virtual SDLSurfacePtr make_screenshot() override;
 
+  /** There are no pixels to capture */
+  virtual void capture_frame(const std::string& filename, bool verbose) override {}
+
+  virtual bool supports_render_thread() const override { return true; }
+
 private:
   Size m_window_size;
   int m_vsync_mode;
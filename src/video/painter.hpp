@@ -46,7 +46,9 @@ public:
   virtual void draw_triangle(const TriangleRequest& request) = 0;
 
   virtual void clear(const Color& color) = 0;
-  virtual void get_pixel(const GetPixelRequest& request) const = 0;
+  /** Reads the color at the position of the request. Called on the
+      RenderThread, if there is one, see Compositor::publish_pixels(). */
+  virtual Color get_pixel(const GetPixelRequest& request) const = 0;
 
   virtual void set_clip_rect(const Rect& rect) = 0;
   virtual void clear_clip_rect() = 0;
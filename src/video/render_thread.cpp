@@ -0,0 +1,156 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/render_thread.hpp"
+
+#include <chrono>
+
+#include "util/log.hpp"
+#include "util/profiler.hpp"
+#include "video/compositor.hpp"
+#include "video/texture.hpp"
+#include "video/video_system.hpp"
+
+void
+RenderThread::delete_texture(Texture* texture)
+{
+  if (auto* render_thread = RenderThread::current())
+  {
+    // The texture cache belongs to the main thread.
+    texture->reap_cache_entry();
+    render_thread->dispose(texture);
+  }
+  else
+    delete texture;
+}
+
+RenderThread::RenderThread(VideoSystem& video_system) :
+  m_video_system(video_system),
+  m_mutex(),
+  m_cond(),
+  m_frame(),
+  m_frame_garbage(),
+  m_garbage(),
+  m_releases(),
+  m_busy(false),
+  m_quit(false),
+  m_last_wait_ms(0.0f),
+  m_thread()
+{
+  m_video_system.render_thread_started();
+  m_thread = std::thread(&RenderThread::run, this);
+
+  log_info << "Rendering on a separate thread" << std::endl;
+}
+
+RenderThread::~RenderThread()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_cond.notify_all();
+  m_thread.join();
+
+  m_video_system.render_thread_stopped();
+
+  // This thread has the context again, what is left is released here.
+  m_frame_garbage.clear();
+  m_garbage.clear();
+  for (const auto& func : m_releases)
+    func();
+  m_releases.clear();
+}
+
+void
+RenderThread::submit(Compositor& compositor)
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cond.wait(lock, [this]{ return !m_frame && !m_busy; });
+
+  m_last_wait_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+  m_video_system.render_thread_submit();
+
+  // The last frame has been rendered, so the textures released before
+  // it can go. The new frame may still draw those released since.
+  std::vector<std::unique_ptr<Texture>> garbage = std::move(m_frame_garbage);
+  m_frame = &compositor;
+  m_frame_garbage = std::move(m_garbage);
+  m_garbage.clear();
+
+  lock.unlock();
+  m_cond.notify_all();
+
+  // Destroying them may call release(), which takes the lock.
+  garbage.clear();
+}
+
+void
+RenderThread::wait_idle()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cond.wait(lock, [this]{ return !m_frame && !m_busy; });
+}
+
+void
+RenderThread::dispose(Texture* texture)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_garbage.emplace_back(texture);
+}
+
+void
+RenderThread::release(std::function<void()> func)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_releases.push_back(std::move(func));
+}
+
+void
+RenderThread::run()
+{
+  Profiler::set_thread_id(2);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_cond.wait(lock, [this]{ return m_frame || m_quit; });
+
+    // Render a frame that is still pending before quitting.
+    if (!m_frame)
+      break;
+
+    Compositor* frame = m_frame;
+    m_frame = nullptr;
+    std::vector<std::function<void()>> releases = std::move(m_releases);
+    m_releases.clear();
+    m_busy = true;
+    lock.unlock();
+
+    m_video_system.render_thread_begin_frame();
+    for (const auto& func : releases)
+      func();
+    frame->render();
+    m_video_system.render_thread_end_frame();
+
+    lock.lock();
+    m_busy = false;
+    m_cond.notify_all();
+  }
+}
@@ -0,0 +1,103 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "util/currenton.hpp"
+
+class Compositor;
+class Texture;
+class VideoSystem;
+
+/** Renders the frames recorded by the main thread on a separate thread,
+    so that the game logic of frame N can run while frame N-1 is being
+    submitted to the GPU. At most one frame is in flight: the main thread
+    records into one Compositor while the render thread works on the
+    other one.
+
+    Textures must outlive every frame that may still draw them, so they
+    are not destroyed right away but handed to dispose(), see
+    delete_texture(). They are destroyed on the main thread, and only
+    their GPU resources are freed on the RenderThread, see release(). */
+class RenderThread final : public Currenton<RenderThread>
+{
+public:
+  /** Deleter for the TexturePtr returned by VideoSystem::new_texture() */
+  static void delete_texture(Texture* texture);
+
+public:
+  RenderThread(VideoSystem& video_system);
+  ~RenderThread() override;
+
+  /** Waits until the previous frame has been rendered, then renders the
+      given one in the background */
+  void submit(Compositor& compositor);
+
+  /** Waits until the frame in flight has been rendered */
+  void wait_idle();
+
+  /** Destroys the texture once the frames that may still use it have
+      been rendered */
+  void dispose(Texture* texture);
+
+  /** Runs \a func on the render thread before its next frame, to free
+      GPU resources without a context on the calling thread */
+  void release(std::function<void()> func);
+
+  /** Time the main thread spent waiting for the render thread in the
+      last submit() */
+  inline float get_last_wait_ms() const { return m_last_wait_ms; }
+
+private:
+  void run();
+
+private:
+  VideoSystem& m_video_system;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+
+  /** The submitted frame, until the render thread picks it up */
+  Compositor* m_frame;
+
+  /** Textures released up to the submission of the last frame, which
+      are destroyed by the next submit(), once that frame is rendered */
+  std::vector<std::unique_ptr<Texture>> m_frame_garbage;
+
+  /** Textures released since the last submit() */
+  std::vector<std::unique_ptr<Texture>> m_garbage;
+
+  /** Functions passed to release() */
+  std::vector<std::function<void()>> m_releases;
+
+  /** true while the render thread works on a frame */
+  bool m_busy;
+  bool m_quit;
+  float m_last_wait_ms;
+
+  std::thread m_thread;
+
+private:
+  RenderThread(const RenderThread&) = delete;
+  RenderThread& operator=(const RenderThread&) = delete;
+};
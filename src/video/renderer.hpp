@@ -29,6 +29,7 @@ struct SDL_Window;
 class Renderer
 {
 public:
+  Renderer() : m_content_signature() {}
   virtual ~Renderer() {}
 
   virtual void start_draw() = 0;
@@ -40,4 +41,12 @@ public:
   virtual Size get_logical_size() const = 0;
 
   virtual TexturePtr get_texture() const = 0;
+
+  /** Identifies what the Compositor last drew into the texture, so that
+      drawing the same again can be skipped, 0 if unknown */
+  inline size_t get_content_signature() const { return m_content_signature; }
+  inline void set_content_signature(size_t signature) { m_content_signature = signature; }
+
+private:
+  size_t m_content_signature;
 };
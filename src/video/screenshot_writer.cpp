@@ -0,0 +1,126 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "video/screenshot_writer.hpp"
+
+#include <stdexcept>
+
+#include "util/log.hpp"
+#include "video/sdl_surface.hpp"
+
+ScreenshotWriter::ScreenshotWriter() :
+  m_mutex(),
+  m_cond(),
+  m_queue(),
+  m_results(),
+  m_quit(false),
+  m_thread()
+{
+}
+
+ScreenshotWriter::~ScreenshotWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_cond.notify_all();
+  if (m_thread.joinable())
+    m_thread.join();
+
+  poll();
+}
+
+void
+ScreenshotWriter::save(SDLSurfacePtr surface, const std::string& filename, bool verbose)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  if (!surface)
+  {
+    m_results.emplace_back(false, "Creating the screenshot \"" + filename + "\" has failed");
+    return;
+  }
+
+  // Most sessions never take a screenshot, so the worker is only started
+  // with the first one.
+  if (!m_thread.joinable())
+    m_thread = std::thread(&ScreenshotWriter::run, this);
+
+  m_cond.wait(lock, [this]{ return m_queue.size() < MAX_PENDING; });
+
+  m_queue.push_back({ std::move(surface), filename, verbose });
+
+  lock.unlock();
+  m_cond.notify_all();
+}
+
+void
+ScreenshotWriter::poll()
+{
+  std::vector<std::pair<bool, std::string>> results;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_results.empty())
+      return;
+    results = std::move(m_results);
+    m_results.clear();
+  }
+
+  for (const auto& [success, message] : results)
+  {
+    if (success)
+      log_info << "Wrote screenshot to \"" << message << "\"" << std::endl;
+    else
+      log_warning << message << std::endl;
+  }
+}
+
+void
+ScreenshotWriter::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_cond.wait(lock, [this]{ return !m_queue.empty() || m_quit; });
+
+    // Write out everything that is still queued before quitting.
+    if (m_queue.empty())
+      break;
+
+    Job job = std::move(m_queue.front());
+    m_queue.pop_front();
+    lock.unlock();
+    m_cond.notify_all();
+
+    std::pair<bool, std::string> result;
+    try
+    {
+      SDLSurface::write_png(*job.surface, job.filename);
+      result = { true, job.filename };
+    }
+    catch (const std::exception& err)
+    {
+      result = { false, err.what() };
+    }
+    job.surface.reset(nullptr);
+
+    lock.lock();
+    if (!result.first || job.verbose)
+      m_results.push_back(std::move(result));
+  }
+}
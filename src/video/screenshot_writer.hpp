@@ -0,0 +1,84 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "video/sdl_surface_ptr.hpp"
+
+/** Encodes and writes captured frames as PNG on a worker thread, so
+    that taking a screenshot or recording a frame sequence does not stall
+    the frame in which it happens.
+
+    save() may be called from the main thread or the RenderThread. The
+    outcome of each write is collected and reported by poll(), which must
+    be called on the main thread, as logging is not thread-safe. */
+class ScreenshotWriter final
+{
+private:
+  /** Number of frames that may wait for encoding before save() blocks */
+  static const size_t MAX_PENDING = 32;
+
+public:
+  ScreenshotWriter();
+  ~ScreenshotWriter();
+
+  /** Queues the surface to be written to the given file. Blocks while
+      MAX_PENDING frames are waiting, so that a frame recording slower than
+      the encoder throttles the game instead of losing frames. If 'verbose'
+      is false, only a failed write is reported. A null surface, from a
+      failed capture, is reported as an error. */
+  void save(SDLSurfacePtr surface, const std::string& filename, bool verbose = true);
+
+  /** Logs the result of every write finished since the last call */
+  void poll();
+
+private:
+  struct Job final
+  {
+    SDLSurfacePtr surface;
+    std::string filename;
+    bool verbose;
+  };
+
+private:
+  void run();
+
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+
+  std::deque<Job> m_queue;
+
+  /** Written file names, or error messages if 'first' is false */
+  std::vector<std::pair<bool, std::string>> m_results;
+
+  bool m_quit;
+
+  std::thread m_thread;
+
+private:
+  ScreenshotWriter(const ScreenshotWriter&) = delete;
+  ScreenshotWriter& operator=(const ScreenshotWriter&) = delete;
+};
@@ -484,8 +484,12 @@ SDLPainter::draw_line(const LineRequest& request)
 
   SDL_SetRenderDrawBlendMode(m_sdl_renderer, SDL_BLENDMODE_BLEND);
   SDL_SetRenderDrawColor(m_sdl_renderer, r, g, b, a);
-  SDL_RenderDrawLineF(m_sdl_renderer, request.pos.x, request.pos.y,
-                                      request.dest_pos.x, request.dest_pos.y);
+  for (size_t i = 0; i + 1 < request.get_point_count(); i += 2)
+  {
+    const Vector p1 = request.get_point(i);
+    const Vector p2 = request.get_point(i + 1);
+    SDL_RenderDrawLineF(m_sdl_renderer, p1.x, p1.y, p2.x, p2.y);
+  }
 }
 
 namespace {
@@ -613,7 +617,7 @@ SDLPainter::clear_clip_rect()
   }
 }
 
-void
+Color
 SDLPainter::get_pixel(const GetPixelRequest& request) const
 {
   const Rect& rect = m_renderer.get_rect();
@@ -635,5 +639,5 @@ SDLPainter::get_pixel(const GetPixelRequest& request) const
     log_warning << "failed to read pixels: " << SDL_GetError() << std::endl;
   }
 
-  *(request.color_ptr) = Color::from_rgb888(pixel[2], pixel[1], pixel[0]);
+  return Color::from_rgb888(pixel[2], pixel[1], pixel[0]);
 }
@@ -22,6 +22,7 @@
 #include <SDL_image.h>
 #include <savepng.h>
 
+#include "physfs/ifile_data.hpp"
 #include "physfs/physfs_sdl.hpp"
 #include "util/log.hpp"
 
@@ -77,7 +78,9 @@ SDLSurfacePtr
 SDLSurface::from_file(const std::string& filename)
 {
   log_debug << "loading image: " << filename << std::endl;
-  SDLSurfacePtr surface(IMG_Load_RW(get_physfs_SDLRWops(filename), 1));
+  // The data only has to outlive IMG_Load_RW(), which decodes eagerly.
+  IFileData data(filename);
+  SDLSurfacePtr surface(IMG_Load_RW(SDL_RWFromConstMem(data.data(), static_cast<int>(data.size())), 1));
   if (!surface)
   {
     std::ostringstream msg;
@@ -92,6 +95,21 @@ SDLSurface::from_file(const std::string& filename)
 
 int
 SDLSurface::save_png(const SDL_Surface& surface, const std::string& filename)
+{
+  try
+  {
+    write_png(surface, filename);
+    return true;
+  }
+  catch (const std::exception& err)
+  {
+    log_warning << err.what() << std::endl;
+    return false;
+  }
+}
+
+void
+SDLSurface::write_png(const SDL_Surface& surface, const std::string& filename)
 {
   // This does not lead to a double free when 'tmp == screen', as
   // SDL_PNGFormatAlpha() will increase the refcount of surface.
@@ -100,18 +118,10 @@ SDLSurface::save_png(const SDL_Surface& surface, const std::string& filename)
   try {
     ops = get_writable_physfs_SDLRWops(filename);
   } catch (std::exception& e) {
-    log_warning << "Could not get SDLRWops for " << filename << ": " <<
-      e.what() << std::endl;
-    return false;
+    throw std::runtime_error("Could not get SDLRWops for " + filename + ": " + e.what());
   }
-  int ret = SDL_SavePNG_RW(tmp.get(), ops, 1);
-  if (ret < 0)
+  if (SDL_SavePNG_RW(tmp.get(), ops, 1) < 0)
   {
-    log_warning << "Saving " << filename << " failed: " << SDL_GetError() << std::endl;
-    return false;
-  }
-  else
-  {
-    return true;
+    throw std::runtime_error("Saving " + filename + " failed: " + SDL_GetError());
   }
 }
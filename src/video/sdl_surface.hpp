@@ -28,4 +28,8 @@ public:
   static SDLSurfacePtr create_rgb(int width, int height);
   static SDLSurfacePtr from_file(const std::string& filename);
   static int save_png(const SDL_Surface& surface, const std::string& filename);
+
+  /** Like save_png(), but throws std::runtime_error instead of logging,
+      so that it can be used off the main thread */
+  static void write_png(const SDL_Surface& surface, const std::string& filename);
 };
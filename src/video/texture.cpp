@@ -31,6 +31,12 @@ Texture::Texture(const Sampler& sampler) :
 }
 
 Texture::~Texture()
+{
+  reap_cache_entry();
+}
+
+void
+Texture::reap_cache_entry()
 {
   if (TextureManager::current() && m_cache_key)
   {
@@ -38,4 +44,5 @@ Texture::~Texture()
     // been cleared. Remove the entry altogether to save memory.
     TextureManager::current()->reap_cache_entry(*m_cache_key);
   }
+  m_cache_key.reset();
 }
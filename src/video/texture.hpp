@@ -54,6 +54,10 @@ public:
 
   inline const Sampler& get_sampler() const { return m_sampler; }
 
+  /** Removes the cache entry of the texture, which the destructor does
+      otherwise. Must be called on the main thread. */
+  void reap_cache_entry();
+
 protected:
   Sampler m_sampler;
 
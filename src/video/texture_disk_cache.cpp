@@ -0,0 +1,223 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "video/texture_disk_cache.hpp"
+
+#include <config.h>
+
+#include <memory>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+#include <physfs.h>
+#ifdef HAVE_LZ4
+#include <lz4.h>
+#endif
+
+namespace {
+
+const char s_directory[] = "cache/textures/";
+
+/** Bump this when the layout of the entries changes */
+const uint32_t s_version = 1;
+
+const uint32_t s_flag_lz4 = 1;
+
+/** Images larger than this in either direction are not cached */
+const int32_t s_max_size = 16384;
+
+/** Written in native byte order, entries are not portable */
+struct Header final
+{
+  char magic[4];
+  uint32_t version;
+  uint32_t flags;
+  int32_t width;
+  int32_t height;
+
+  /** Number of bytes of pixel data following the header */
+  uint32_t data_size;
+
+  /** Of the file the pixels were decoded from, to notice changes */
+  int64_t source_mtime;
+  int64_t source_size;
+};
+static_assert(sizeof(Header) == 40, "Header must not contain padding");
+
+using FilePtr = std::unique_ptr<PHYSFS_File, int (*)(PHYSFS_File*)>;
+
+bool stat_source(const std::string& filename, int64_t& size, int64_t& mtime)
+{
+  PHYSFS_Stat stat;
+  if (!PHYSFS_stat(filename.c_str(), &stat) || stat.filetype != PHYSFS_FILETYPE_REGULAR)
+    return false;
+
+  size = stat.filesize;
+  mtime = stat.modtime;
+  return true;
+}
+
+bool read_exactly(PHYSFS_File* file, void* buffer, size_t size)
+{
+  return PHYSFS_readBytes(file, buffer, size) == static_cast<PHYSFS_sint64>(size);
+}
+
+bool write_exactly(PHYSFS_File* file, const void* buffer, size_t size)
+{
+  return PHYSFS_writeBytes(file, buffer, size) == static_cast<PHYSFS_sint64>(size);
+}
+
+} // namespace
+
+namespace TextureDiskCache {
+
+std::string
+get_path(const std::string& filename)
+{
+  return s_directory + filename + ".rgba";
+}
+
+SDLSurfacePtr
+load(const std::string& filename)
+{
+  int64_t source_size;
+  int64_t source_mtime;
+  if (!stat_source(filename, source_size, source_mtime))
+    return SDLSurfacePtr();
+
+  const std::string path = get_path(filename);
+  FilePtr file(PHYSFS_openRead(path.c_str()), PHYSFS_close);
+  if (!file)
+    return SDLSurfacePtr();
+
+  Header header;
+  if (!read_exactly(file.get(), &header, sizeof(header)) ||
+      memcmp(header.magic, "STTC", 4) != 0 ||
+      header.version != s_version ||
+      header.source_size != source_size ||
+      header.source_mtime != source_mtime ||
+      header.width <= 0 || header.width > s_max_size ||
+      header.height <= 0 || header.height > s_max_size)
+  {
+    return SDLSurfacePtr();
+  }
+
+  SDLSurfacePtr surface(SDL_CreateRGBSurfaceWithFormat(0, header.width, header.height, 32,
+                                                       SDL_PIXELFORMAT_RGBA32));
+  if (!surface || surface->pitch != header.width * 4)
+    return SDLSurfacePtr();
+
+  const size_t pixels_size = static_cast<size_t>(header.width) * header.height * 4;
+  if (header.flags == 0)
+  {
+    if (header.data_size != pixels_size ||
+        !read_exactly(file.get(), surface->pixels, pixels_size))
+    {
+      return SDLSurfacePtr();
+    }
+  }
+#ifdef HAVE_LZ4
+  else if (header.flags == s_flag_lz4)
+  {
+    if (header.data_size > static_cast<uint32_t>(LZ4_compressBound(static_cast<int>(pixels_size))))
+      return SDLSurfacePtr();
+
+    std::vector<char> data(header.data_size);
+    if (!read_exactly(file.get(), data.data(), data.size()) ||
+        LZ4_decompress_safe(data.data(), static_cast<char*>(surface->pixels),
+                            static_cast<int>(data.size()),
+                            static_cast<int>(pixels_size)) != static_cast<int>(pixels_size))
+    {
+      return SDLSurfacePtr();
+    }
+  }
+#endif
+  else
+  {
+    // Written by a build with a compression this one doesn't have.
+    return SDLSurfacePtr();
+  }
+
+  return surface;
+}
+
+bool
+store(const std::string& filename, const SDL_Surface& surface)
+{
+  if (surface.format->format != SDL_PIXELFORMAT_RGBA32 || SDL_MUSTLOCK(&surface) ||
+      surface.w <= 0 || surface.w > s_max_size ||
+      surface.h <= 0 || surface.h > s_max_size)
+  {
+    return false;
+  }
+
+  Header header;
+  memcpy(header.magic, "STTC", 4);
+  header.version = s_version;
+  header.flags = 0;
+  header.width = surface.w;
+  header.height = surface.h;
+  if (!stat_source(filename, header.source_size, header.source_mtime))
+    return false;
+
+  // The rows of subregions aren't contiguous.
+  const size_t row_length = static_cast<size_t>(surface.w) * 4;
+  std::vector<char> pixels;
+  const char* data = static_cast<const char*>(surface.pixels);
+  if (surface.pitch != static_cast<int>(row_length))
+  {
+    pixels.resize(row_length * surface.h);
+    for (int y = 0; y < surface.h; ++y)
+      memcpy(pixels.data() + y * row_length, data + y * surface.pitch, row_length);
+    data = pixels.data();
+  }
+  size_t data_size = row_length * surface.h;
+
+#ifdef HAVE_LZ4
+  std::vector<char> compressed(LZ4_compressBound(static_cast<int>(data_size)));
+  const int compressed_size = LZ4_compress_default(data, compressed.data(), static_cast<int>(data_size),
+                                                   static_cast<int>(compressed.size()));
+  if (compressed_size > 0)
+  {
+    header.flags = s_flag_lz4;
+    data = compressed.data();
+    data_size = compressed_size;
+  }
+#endif
+  header.data_size = static_cast<uint32_t>(data_size);
+
+  const std::string path = get_path(filename);
+  const std::string directory = path.substr(0, path.rfind('/'));
+  if (!PHYSFS_mkdir(directory.c_str()))
+    return false;
+
+  FilePtr file(PHYSFS_openWrite(path.c_str()), PHYSFS_close);
+  if (!file)
+    return false;
+
+  if (!write_exactly(file.get(), &header, sizeof(header)) ||
+      !write_exactly(file.get(), data, data_size))
+  {
+    // Don't leave a truncated entry behind.
+    file.reset();
+    PHYSFS_delete(path.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // namespace TextureDiskCache
@@ -0,0 +1,43 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <string>
+
+#include "video/sdl_surface_ptr.hpp"
+
+/** Images converted to 32-bit RGBA, kept in the user directory so that
+    they don't have to be decoded again. Entries are compressed with LZ4
+    if SuperTux was built with it, and are only valid on the machine
+    that wrote them.
+
+    The functions may be called from worker threads. They don't log or
+    throw, failures are reported by the return value only. */
+namespace TextureDiskCache {
+
+/** Returns the cached pixels of \a filename, or nullptr if there are
+    none or the file changed since they were stored */
+SDLSurfacePtr load(const std::string& filename);
+
+/** Stores \a surface, which has to be 32-bit RGBA, as the pixels of
+    \a filename */
+bool store(const std::string& filename, const SDL_Surface& surface);
+
+/** Returns the path of the entry of \a filename */
+std::string get_path(const std::string& filename);
+
+} // namespace TextureDiskCache
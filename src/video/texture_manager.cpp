@@ -17,13 +17,22 @@
 #include "video/texture_manager.hpp"
 
 #include <SDL_image.h>
+#include <algorithm>
 #include <assert.h>
+#include <atomic>
+#include <chrono>
+#include <limits>
 #include <sstream>
+#include <thread>
+#include <unordered_set>
 
 #include <physfs.h>
 
 #include "math/rect.hpp"
+#include "physfs/ifile_data.hpp"
 #include "physfs/physfs_sdl.hpp"
+#include "supertux/gameconfig.hpp"
+#include "supertux/globals.hpp"
 #include "util/file_system.hpp"
 #include "util/log.hpp"
 #include "util/reader_document.hpp"
@@ -33,6 +42,7 @@
 #include "video/sampler.hpp"
 #include "video/sdl_surface.hpp"
 #include "video/texture.hpp"
+#include "video/texture_disk_cache.hpp"
 #include "video/video_system.hpp"
 
 namespace {
@@ -86,13 +96,34 @@ SDLSurfacePtr create_image_surface(const std::string& filename)
                                FileSystem::extension(filename));
 }
 
+/** Decodes \a filename and converts it to 32-bit RGBA, the format
+    GLTexture uploads without copying. The alpha stays straight, which
+    is what the blend modes and shaders expect. Nothing is logged, as
+    this runs on worker threads; failures are left to the regular load
+    path. */
+SDLSurfacePtr decode_image_surface(const std::string& filename)
+{
+  IFileData data(filename);
+  SDLSurfacePtr surface(IMG_Load_RW(SDL_RWFromConstMem(data.data(), static_cast<int>(data.size())), 1));
+  if (!surface || surface->format->format == SDL_PIXELFORMAT_RGBA32)
+  {
+    return surface;
+  }
+
+  return SDLSurfacePtr(SDL_ConvertSurfaceFormat(surface.get(), SDL_PIXELFORMAT_RGBA32, 0));
+}
+
 } // namespace
 
 const std::string TextureManager::s_dummy_texture = "images/engine/missing.png";
+const size_t TextureManager::s_upload_budget = 4 * 1024 * 1024;
 
 TextureManager::TextureManager() :
   m_image_textures(),
   m_surfaces(),
+  m_preloaded(),
+  m_pending_uploads(),
+  m_defer_uploads(false),
   m_load_successful(false)
 {
 }
@@ -107,7 +138,9 @@ TextureManager::~TextureManager()
     }
   }
   m_image_textures.clear();
+  m_pending_uploads.clear();
   m_surfaces.clear();
+  m_preloaded.clear();
 }
 
 TexturePtr
@@ -269,7 +302,7 @@ TextureManager::create_image_texture(const std::string& filename, const Rect& re
   try
   {
     SDLSurfacePtr surface = create_image_surface_raw(filename, rect, sampler);
-    return VideoSystem::current()->new_texture(*surface, sampler);
+    return new_texture(std::move(surface), sampler);
   }
   catch(const std::exception& err)
   {
@@ -288,10 +321,172 @@ TextureManager::get_surface(const std::string& filename)
     return *i->second;
   }
 
-  SDLSurfacePtr surface = create_image_surface(filename);
+  SDLSurfacePtr surface = take_preloaded(filename);
+  if (!surface)
+  {
+    surface = create_image_surface(filename);
+  }
   return *(m_surfaces[filename] = std::move(surface));
 }
 
+SDLSurfacePtr
+TextureManager::take_preloaded(const std::string& filename)
+{
+  auto it = m_preloaded.find(filename);
+  if (it == m_preloaded.end())
+  {
+    return SDLSurfacePtr();
+  }
+
+  SDLSurfacePtr surface = std::move(it->second);
+  m_preloaded.erase(it);
+  return surface;
+}
+
+void
+TextureManager::drop_preloaded()
+{
+  m_preloaded.clear();
+  m_defer_uploads = false;
+}
+
+TexturePtr
+TextureManager::new_texture(SDLSurfacePtr surface, const Sampler& sampler)
+{
+  if (m_defer_uploads &&
+      surface->format->format == SDL_PIXELFORMAT_RGBA32 &&
+      !SDL_MUSTLOCK(surface.get()))
+  {
+    TexturePtr texture = VideoSystem::current()->new_deferred_texture(surface->w, surface->h, sampler);
+    if (texture)
+    {
+      m_pending_uploads.push_back(PendingUpload{texture, std::move(surface)});
+      return texture;
+    }
+  }
+
+  return VideoSystem::current()->new_texture(*surface, sampler);
+}
+
+void
+TextureManager::upload_pending()
+{
+  upload(s_upload_budget);
+}
+
+void
+TextureManager::finish_uploads()
+{
+  upload(std::numeric_limits<size_t>::max());
+}
+
+void
+TextureManager::upload(size_t budget)
+{
+  size_t uploaded = 0;
+  while (!m_pending_uploads.empty() && uploaded < budget)
+  {
+    PendingUpload pending = std::move(m_pending_uploads.front());
+    m_pending_uploads.pop_front();
+
+    // Textures that were already freed again are skipped.
+    if (TexturePtr texture = pending.texture.lock())
+    {
+      VideoSystem::current()->upload_texture(*texture, *pending.surface);
+      uploaded += static_cast<size_t>(pending.surface->w) * pending.surface->h * 4;
+    }
+  }
+}
+
+void
+TextureManager::preload(const std::vector<std::string>& filenames)
+{
+  const auto start_time = std::chrono::steady_clock::now();
+  m_defer_uploads = true;
+
+  std::vector<std::string> pending;
+  std::unordered_set<std::string> seen;
+  for (const auto& name : filenames)
+  {
+    const std::string filename = FileSystem::normalize(name);
+    if (m_surfaces.find(filename) == m_surfaces.end() &&
+        m_preloaded.find(filename) == m_preloaded.end() &&
+        seen.insert(filename).second &&
+        PHYSFS_exists(filename.c_str()))
+    {
+      pending.push_back(filename);
+    }
+  }
+
+  if (pending.empty())
+  {
+    return;
+  }
+
+  const bool use_cache = g_config->texture_cache;
+  std::vector<SDLSurfacePtr> surfaces(pending.size());
+  std::atomic<size_t> next(0);
+  std::atomic<size_t> cached(0);
+  auto worker = [&]()
+  {
+    for (size_t i = next++; i < pending.size(); i = next++)
+    {
+      if (use_cache)
+      {
+        surfaces[i] = TextureDiskCache::load(pending[i]);
+        if (surfaces[i])
+        {
+          ++cached;
+          continue;
+        }
+      }
+
+      try
+      {
+        surfaces[i] = decode_image_surface(pending[i]);
+      }
+      catch (const std::exception&)
+      {
+        // Reported by get() once the image is actually requested.
+      }
+
+      if (use_cache && surfaces[i])
+      {
+        TextureDiskCache::store(pending[i], *surfaces[i]);
+      }
+    }
+  };
+
+#ifdef __EMSCRIPTEN__
+  const size_t thread_count = 1;
+#else
+  const size_t thread_count = std::min<size_t>(pending.size(),
+                                               std::max(1u, std::thread::hardware_concurrency()));
+#endif
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < thread_count; ++i)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < pending.size(); ++i)
+  {
+    if (surfaces[i])
+    {
+      m_preloaded[pending[i]] = std::move(surfaces[i]);
+    }
+  }
+
+  log_info << "Preloaded " << pending.size() << " images (" << cached.load() << " from the texture cache) in "
+           << std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_time).count()
+           << " ms" << std::endl;
+}
+
 SDLSurfacePtr
 TextureManager::create_image_surface_raw(const std::string& filename, const Rect& rect, const Sampler& sampler)
 {
@@ -361,8 +556,12 @@ TextureManager::create_image_texture(const std::string& filename, const Sampler&
   m_load_successful = true;
   try
   {
-    SDLSurfacePtr surface = create_image_surface(filename);
-    return VideoSystem::current()->new_texture(*surface, sampler);
+    SDLSurfacePtr surface = take_preloaded(filename);
+    if (!surface)
+    {
+      surface = create_image_surface(filename);
+    }
+    return new_texture(std::move(surface), sampler);
   }
   catch (const std::exception& err)
   {
@@ -408,6 +607,10 @@ TextureManager::create_dummy_texture() const
 void
 TextureManager::reload()
 {
+  // Pending surfaces may point into the surfaces replaced below.
+  finish_uploads();
+  m_preloaded.clear();
+
   // Reload surfaces
   for (auto& surface : m_surfaces)
   {
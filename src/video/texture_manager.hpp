@@ -17,6 +17,7 @@
 #pragma once
 
 #include <config.h>
+#include <deque>
 #include <unordered_map>
 #include <map>
 #include <memory>
@@ -44,6 +45,9 @@ class TextureManager final : public Currenton<TextureManager>
 private:
   static const std::string s_dummy_texture;
 
+  /** Number of bytes upload_pending() uploads per frame */
+  static const size_t s_upload_budget;
+
 public:
   TextureManager();
   ~TextureManager() override;
@@ -57,14 +61,46 @@ public:
 
   void reload();
 
+  /** Decodes the given image files on worker threads and converts them
+      to the format textures are uploaded in, so that a following get()
+      of one of them only has to upload it. Converted images are read
+      from and written to the TextureDiskCache, if enabled. Files that
+      can't be decoded are skipped here, get() reports them as usual.
+
+      Until drop_preloaded(), textures are created without uploading
+      their pixels, that is left to upload_pending(). */
+  void preload(const std::vector<std::string>& filenames);
+
+  /** Frees the surfaces preload() decoded that were never requested */
+  void drop_preloaded();
+
+  /** Uploads the pixels of textures created since preload(), up to
+      s_upload_budget bytes per call. Called once per frame, so textures
+      are blank for the first few frames after a tileset is loaded. */
+  void upload_pending();
+
+  /** Uploads the pixels of all textures created since preload() */
+  void finish_uploads();
+
   void debug_print(std::ostream& out) const;
 
   inline bool last_load_successful() const { return m_load_successful; }
 
 private:
   const SDL_Surface& get_surface(const std::string& filename);
+
+  /** Returns the surface preload() decoded for \a filename, if any, and
+      removes it from the preloaded set */
+  SDLSurfacePtr take_preloaded(const std::string& filename);
   void reap_cache_entry(const Texture::Key& key);
 
+  /** Creates the texture of \a surface, deferring the upload of its
+      pixels if a preload() is in progress */
+  TexturePtr new_texture(SDLSurfacePtr surface, const Sampler& sampler);
+
+  /** Uploads pending textures until \a budget bytes were uploaded */
+  void upload(size_t budget);
+
   /** on failure a dummy texture is returned and no exception is thrown */
   TexturePtr create_image_texture(const std::string& filename, const Sampler& sampler);
 
@@ -78,6 +114,21 @@ private:
 private:
   std::map<Texture::Key, std::weak_ptr<Texture>> m_image_textures;
   std::unordered_map<std::string, SDLSurfacePtr> m_surfaces;
+
+  /** Surfaces decoded by preload() that no texture was created from yet */
+  std::unordered_map<std::string, SDLSurfacePtr> m_preloaded;
+
+  /** A texture whose pixels are still to be uploaded. Surfaces of
+      subregions point into m_surfaces. */
+  struct PendingUpload final
+  {
+    std::weak_ptr<Texture> texture;
+    SDLSurfacePtr surface;
+  };
+  std::deque<PendingUpload> m_pending_uploads;
+
+  /** Whether textures are created with new_deferred_texture() */
+  bool m_defer_uploads;
   bool m_load_successful;
 
 private:
@@ -17,6 +17,8 @@
 
 #include "video/ttf_font.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <numeric>
 #include <sstream>
@@ -143,51 +145,29 @@ TTFFont::draw_text(Canvas& canvas, const std::string& text,
   return Rectf(min_x, init_y, min_x + max_width, last_y);
 }
 
-std::string
-TTFFont::wrap_to_width(const std::string& text, float width, std::string* overflow)
+size_t
+TTFFont::get_fitting_length(const std::string& line, float width) const
 {
-  std::string s = text;
-
-  // if text is already smaller, return full text
-  if (get_text_width(s) <= width) {
-    if (overflow) *overflow = "";
-    return s;
-  }
-
-  // if we can find a whitespace character to break at, return text up to this character
-  for (int i = static_cast<int>(s.length()) - 1; i >= 0; i--) {
-    std::string s2 = s.substr(0,i);
-    if (s[i] != ' ') continue;
-    if (get_text_width(s2) <= width) {
-      if (overflow) *overflow = s.substr(i+1);
-      return s.substr(0, i);
-    }
+  if (line.empty())
+    return 0;
+
+  // Same measure as get_text_width(), which adds the border and shadow.
+  const int grow = std::max(get_border() * 2, get_shadow_size() * 2);
+  int extent = 0;
+  int count = 0;
+  if (TTF_MeasureUTF8(m_font, line.c_str(), static_cast<int>(std::floor(width)) - grow, &extent, &count) < 0)
+  {
+    get_logging_instance(false) << "TTFFont::get_fitting_length(): " << TTF_GetError() << std::endl;
+    return line.size();
   }
 
-  // hard-wrap at width, taking care of multibyte characters
-  unsigned int char_bytes = 1;
-  for (int i = 0; i < static_cast<int>(s.length()); i += char_bytes) {
-
-    // calculate the number of bytes in the character
-    char_bytes = 1;
-    auto iter = s.begin() + i + 1; // iter points to next byte
-    while ( iter != s.end() && (*iter & 128) && !(*iter & 64) ) {
-      // this is a "continuation" byte in the form 10xxxxxx
-      ++iter;
-      ++char_bytes;
-    }
-
-    // check whether text now goes over allowed width, and if so
-    // return everything up to the character and put the rest in the overflow
-    std::string s2 = s.substr(0,i+char_bytes);
-    if (get_text_width(s2) > width) {
-      if (i == 0) i += char_bytes; // edge case when even one char is too wide
-      if (overflow) *overflow = s.substr(i);
-      return s.substr(0, i);
-    }
+  // The count is in characters, not bytes.
+  std::string::size_type pos = 0;
+  for (int i = 0; i < count && pos < line.size(); ++i)
+  {
+    ++pos;
+    while (pos < line.size() && (line[pos] & 0xC0) == 0x80)
+      ++pos;
   }
-
-  // should in theory never reach here
-  if (overflow) *overflow = "";
-  return s;
+  return pos;
 }
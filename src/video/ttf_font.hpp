@@ -43,8 +43,6 @@ public:
   virtual float get_text_width(const std::string& text) const override;
   virtual float get_text_height(const std::string& text) const override;
 
-  virtual std::string wrap_to_width(const std::string& text, float width, std::string* overflow) override;
-
   virtual Rectf draw_text(Canvas& canvas, const std::string& text,
                           const Vector& pos, FontAlignment alignment, int layer, const Color& color) override;
 
@@ -53,6 +51,9 @@ public:
 
   inline TTF_Font* get_ttf_font() const { return m_font; }
 
+protected:
+  virtual size_t get_fitting_length(const std::string& line, float width) const override;
+
 private:
   TTF_Font* m_font;
   std::string m_filename;
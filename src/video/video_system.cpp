@@ -27,14 +27,26 @@
 #include "util/gettext.hpp"
 #include "util/log.hpp"
 #include "video/null/null_video_system.hpp"
+#include "video/screenshot_writer.hpp"
 #include "video/sdl/sdl_video_system.hpp"
-#include "video/sdl_surface.hpp"
 #include "video/sdl_surface_ptr.hpp"
+#include "video/texture.hpp"
 
 #ifdef HAVE_OPENGL
 #  include "video/gl/gl_video_system.hpp"
 #endif
 
+VideoSystem::VideoSystem() :
+  m_screenshot_writer(std::make_unique<ScreenshotWriter>()),
+  m_screenshot_request(),
+  m_screenshot_number(0)
+{
+}
+
+VideoSystem::~VideoSystem()
+{
+}
+
 std::unique_ptr<VideoSystem>
 VideoSystem::create(VideoSystem::Enum video_system)
 {
@@ -165,12 +177,6 @@ VideoSystem::get_available_video_systems()
 void
 VideoSystem::do_take_screenshot()
 {
-  SDLSurfacePtr surface = make_screenshot();
-  if (!surface) {
-    log_warning << "Creating the screenshot has failed" << std::endl;
-    return;
-  }
-
   const std::string screenshots_dir = "/screenshots";
   if (!PHYSFS_exists(screenshots_dir.c_str())) {
     if (!PHYSFS_mkdir(screenshots_dir.c_str())) {
@@ -181,12 +187,13 @@ VideoSystem::do_take_screenshot()
 
   auto find_filename = [&]() -> std::optional<std::string>
     {
-      for (int num = 0; num < 1000000; ++num)
+      for (int num = m_screenshot_number; num < 1000000; ++num)
       {
         std::ostringstream oss;
         oss << "screenshot" << std::setw(6) << std::setfill('0') << num << ".png";
         const std::string screenshot_filename = FileSystem::join(screenshots_dir, oss.str());
         if (!PHYSFS_exists(screenshot_filename.c_str())) {
+          m_screenshot_number = num + 1;
           #ifdef __clang__
             return std::move(screenshot_filename);
           #else
@@ -204,8 +211,46 @@ VideoSystem::do_take_screenshot()
   }
   else
   {
-    if (SDLSurface::save_png(*surface, *filename)) {
-      log_info << "Wrote screenshot to \"" << *filename << "\"" << std::endl;
-    }
+    m_screenshot_request = *filename;
   }
 }
+
+std::string
+VideoSystem::take_screenshot_request()
+{
+  std::string filename = std::move(m_screenshot_request);
+  m_screenshot_request.clear();
+  return filename;
+}
+
+TexturePtr
+VideoSystem::new_deferred_texture(int width, int height, const Sampler& sampler)
+{
+  return TexturePtr();
+}
+
+void
+VideoSystem::upload_texture(Texture& texture, const SDL_Surface& image)
+{
+  texture.reload(image);
+}
+
+void
+VideoSystem::capture_frame(const std::string& filename, bool verbose)
+{
+  // This may run on the RenderThread, so a failure is reported through
+  // the ScreenshotWriter, see poll_screenshots().
+  save_screenshot(make_screenshot(), filename, verbose);
+}
+
+void
+VideoSystem::save_screenshot(SDLSurfacePtr surface, const std::string& filename, bool verbose)
+{
+  m_screenshot_writer->save(std::move(surface), filename, verbose);
+}
+
+void
+VideoSystem::poll_screenshots()
+{
+  m_screenshot_writer->poll();
+}
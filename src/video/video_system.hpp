@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <SDL.h>
@@ -29,6 +30,7 @@ class Rect;
 class Renderer;
 class SDLSurfacePtr;
 class Sampler;
+class ScreenshotWriter;
 class Surface;
 class SurfaceData;
 class Viewport;
@@ -58,8 +60,8 @@ public:
   static std::vector<Info> get_available_video_systems();
 
 public:
-  VideoSystem() {}
-  ~VideoSystem() override {}
+  VideoSystem();
+  ~VideoSystem() override;
 
   /** Return a human readable name of the current video system */
   virtual std::string get_name() const = 0;
@@ -70,6 +72,15 @@ public:
 
   virtual TexturePtr new_texture(const SDL_Surface& image, const Sampler& sampler = Sampler()) = 0;
 
+  /** Creates a texture of the given size whose pixels are only filled
+      in later by upload_texture(), or nullptr if the video system can't
+      defer the upload */
+  virtual TexturePtr new_deferred_texture(int width, int height, const Sampler& sampler);
+
+  /** Fills a texture made by new_deferred_texture() with \a image,
+      which is 32-bit RGBA and has the size of the texture */
+  virtual void upload_texture(Texture& texture, const SDL_Surface& image);
+
   virtual const Viewport& get_viewport() const = 0;
   virtual void apply_config() = 0;
   virtual void flip() = 0;
@@ -82,8 +93,51 @@ public:
   virtual void set_icon(const SDL_Surface& icon) = 0;
   virtual SDLSurfacePtr make_screenshot() = 0;
 
+  /** Picks a free file name in the screenshots directory for a capture
+      of the next rendered frame, see take_screenshot_request() */
   void do_take_screenshot();
 
+  /** Returns and clears the file name picked by do_take_screenshot(),
+      empty if no screenshot was requested */
+  std::string take_screenshot_request();
+
+  /** Captures the frame that was just rendered, right before flip(), and
+      writes it to the given file in the background. Called on the thread
+      that renders, which may be a RenderThread. */
+  virtual void capture_frame(const std::string& filename, bool verbose);
+
+  /** Logs the outcome of the screenshots written since the last call,
+      called once per frame on the main thread */
+  void poll_screenshots();
+
+  /** Whether frames can be rendered on a RenderThread */
+  virtual bool supports_render_thread() const { return false; }
+
+  /** Called on the main thread when a RenderThread is created and after
+      it has been joined */
+  virtual void render_thread_started() {}
+  virtual void render_thread_stopped() {}
+
+  /** Called on the main thread right before a frame is handed over to
+      the RenderThread */
+  virtual void render_thread_submit() {}
+
+  /** Called on the RenderThread around rendering each frame */
+  virtual void render_thread_begin_frame() {}
+  virtual void render_thread_end_frame() {}
+
+protected:
+  /** Hands the surface to the ScreenshotWriter to be encoded */
+  void save_screenshot(SDLSurfacePtr surface, const std::string& filename, bool verbose);
+
+private:
+  std::unique_ptr<ScreenshotWriter> m_screenshot_writer;
+  std::string m_screenshot_request;
+
+  /** Screenshots are numbered from here, so that the names picked for
+      screenshots which haven't been written yet aren't reused */
+  int m_screenshot_number;
+
 private:
   VideoSystem(const VideoSystem&) = delete;
   VideoSystem& operator=(const VideoSystem&) = delete;
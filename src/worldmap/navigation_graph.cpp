@@ -0,0 +1,246 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include "worldmap/navigation_graph.hpp"
+
+#include <limits>
+#include <queue>
+
+#include "supertux/tile.hpp"
+#include "worldmap/level_tile.hpp"
+#include "worldmap/special_tile.hpp"
+#include "worldmap/teleporter.hpp"
+#include "worldmap/worldmap_sector.hpp"
+
+namespace worldmap {
+
+namespace {
+
+uint64_t tile_key(const Vector& pos)
+{
+  return (static_cast<uint64_t>(static_cast<uint32_t>(static_cast<int>(pos.x))) << 32) |
+         static_cast<uint32_t>(static_cast<int>(pos.y));
+}
+
+int direction_count(int tile_data)
+{
+  return ((tile_data & Tile::WORLDMAP_NORTH) ? 1 : 0) +
+         ((tile_data & Tile::WORLDMAP_SOUTH) ? 1 : 0) +
+         ((tile_data & Tile::WORLDMAP_EAST) ? 1 : 0) +
+         ((tile_data & Tile::WORLDMAP_WEST) ? 1 : 0);
+}
+
+} // namespace
+
+NavigationGraph::NavigationGraph() :
+  m_sector(nullptr),
+  m_nodes(),
+  m_node_index()
+{
+}
+
+void
+NavigationGraph::clear()
+{
+  m_sector = nullptr;
+  m_nodes.clear();
+  m_node_index.clear();
+}
+
+void
+NavigationGraph::build(const WorldMapSector& sector)
+{
+  clear();
+  m_sector = &sector;
+
+  const int width = static_cast<int>(sector.get_tiles_width());
+  const int height = static_cast<int>(sector.get_tiles_height());
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      const Vector pos(static_cast<float>(x), static_cast<float>(y));
+      if (is_node(pos))
+      {
+        m_node_index[tile_key(pos)] = static_cast<int>(m_nodes.size());
+        m_nodes.push_back({ pos, {} });
+      }
+    }
+  }
+
+  for (auto& node : m_nodes)
+  {
+    for (const auto direction : { Direction::NORTH, Direction::SOUTH, Direction::EAST, Direction::WEST })
+    {
+      Edge edge;
+      if (trace(node.pos, direction, edge))
+        node.edges.push_back(std::move(edge));
+    }
+  }
+}
+
+bool
+NavigationGraph::is_node(const Vector& pos) const
+{
+  const int tile_data = m_sector->tile_data_at(pos);
+  if (!(tile_data & Tile::WORLDMAP_DIR_MASK))
+    return false;
+
+  return (tile_data & Tile::WORLDMAP_STOP) ||
+         direction_count(tile_data) != 2 ||
+         m_sector->at_object<LevelTile>(pos) ||
+         m_sector->at_object<Teleporter>(pos) ||
+         m_sector->at_object<SpecialTile>(pos);
+}
+
+int
+NavigationGraph::find_node(const Vector& pos) const
+{
+  auto it = m_node_index.find(tile_key(pos));
+  return it == m_node_index.end() ? -1 : it->second;
+}
+
+bool
+NavigationGraph::trace(const Vector& pos, Direction direction, Edge& edge) const
+{
+  edge.steps.clear();
+
+  // Every tile is passed at most once between two nodes.
+  const size_t max_steps = static_cast<size_t>(m_sector->get_tiles_width() * m_sector->get_tiles_height());
+
+  Vector current = pos;
+  while (edge.steps.size() < max_steps)
+  {
+    Vector next;
+    if (!m_sector->path_ok(direction, current, &next))
+      return false;
+
+    edge.steps.push_back(direction);
+    current = next;
+
+    edge.target = find_node(current);
+    if (edge.target >= 0)
+      return true;
+
+    // Continue the way Tux does when walking on his own, which on a
+    // tile with two directions is the one he didn't come from.
+    const int tile_data = m_sector->tile_data_at(current);
+    const Direction back = reverse_dir(direction);
+    if (tile_data & Tile::WORLDMAP_NORTH && back != Direction::NORTH)
+      direction = Direction::NORTH;
+    else if (tile_data & Tile::WORLDMAP_SOUTH && back != Direction::SOUTH)
+      direction = Direction::SOUTH;
+    else if (tile_data & Tile::WORLDMAP_EAST && back != Direction::EAST)
+      direction = Direction::EAST;
+    else if (tile_data & Tile::WORLDMAP_WEST && back != Direction::WEST)
+      direction = Direction::WEST;
+    else
+      return false;
+  }
+
+  return false;
+}
+
+std::vector<Direction>
+NavigationGraph::find_path(const Vector& from, const Vector& to,
+                           const std::function<bool (const Vector&)>& is_blocked) const
+{
+  const int target = find_node(to);
+  if (!m_sector || target < 0)
+    return {};
+
+  // Tux may stand between two nodes, so the ways to the nodes around
+  // him are traced for the start.
+  std::vector<Edge> start_edges;
+  const int start = find_node(from);
+  if (start >= 0)
+  {
+    if (start == target)
+      return {};
+    start_edges = m_nodes[start].edges;
+  }
+  else
+  {
+    for (const auto direction : { Direction::NORTH, Direction::SOUTH, Direction::EAST, Direction::WEST })
+    {
+      Edge edge;
+      if (trace(from, direction, edge))
+        start_edges.push_back(std::move(edge));
+    }
+  }
+
+  // Dijkstra, with the number of steps as the length of an edge.
+  const size_t none = std::numeric_limits<size_t>::max();
+  std::vector<size_t> distance(m_nodes.size(), none);
+  std::vector<const Edge*> via(m_nodes.size(), nullptr);
+  std::vector<int> previous(m_nodes.size(), -1);
+
+  using Entry = std::pair<size_t, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+  for (const auto& edge : start_edges)
+  {
+    if (edge.steps.size() < distance[edge.target])
+    {
+      distance[edge.target] = edge.steps.size();
+      via[edge.target] = &edge;
+      previous[edge.target] = -1;
+      queue.push({ edge.steps.size(), edge.target });
+    }
+  }
+
+  while (!queue.empty())
+  {
+    const auto [dist, node] = queue.top();
+    queue.pop();
+
+    if (dist != distance[node])
+      continue;
+    if (node == target)
+      break;
+    if (node == start || is_blocked(m_nodes[node].pos))
+      continue;
+
+    for (const auto& edge : m_nodes[node].edges)
+    {
+      const size_t next_dist = dist + edge.steps.size();
+      if (next_dist < distance[edge.target])
+      {
+        distance[edge.target] = next_dist;
+        via[edge.target] = &edge;
+        previous[edge.target] = node;
+        queue.push({ next_dist, edge.target });
+      }
+    }
+  }
+
+  if (distance[target] == none)
+    return {};
+
+  std::vector<const Edge*> edges;
+  for (int node = target; node >= 0; node = previous[node])
+    edges.push_back(via[node]);
+
+  std::vector<Direction> steps;
+  steps.reserve(distance[target]);
+  for (auto it = edges.rbegin(); it != edges.rend(); ++it)
+    steps.insert(steps.end(), (*it)->steps.begin(), (*it)->steps.end());
+
+  return steps;
+}
+
+} // namespace worldmap
@@ -0,0 +1,84 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#pragma once
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+
+#include "math/vector.hpp"
+#include "worldmap/direction.hpp"
+
+namespace worldmap {
+
+class WorldMapSector;
+
+/** Graph of the paths of a worldmap sector. Nodes are the tiles Tux
+    stops at or can take another way on: levels, teleporters, special
+    tiles, stop tiles, crossings and dead ends. Edges are the paths in
+    between, stored as the steps Tux takes along them. */
+class NavigationGraph final
+{
+public:
+  NavigationGraph();
+
+  /** Builds the graph from the paths and objects of @c sector */
+  void build(const WorldMapSector& sector);
+  void clear();
+
+  /** Returns the direction of each step on the shortest path from
+      @c from to @c to, which doesn't pass any node @c is_blocked returns
+      true for. Empty if there is no such path. @c to has to be a node,
+      @c from can be any tile on a path. */
+  std::vector<Direction> find_path(const Vector& from, const Vector& to,
+                                   const std::function<bool (const Vector&)>& is_blocked) const;
+
+  inline size_t get_node_count() const { return m_nodes.size(); }
+
+private:
+  struct Edge
+  {
+    int target;
+    std::vector<Direction> steps;
+  };
+
+  struct Node
+  {
+    Vector pos;
+    std::vector<Edge> edges;
+  };
+
+private:
+  bool is_node(const Vector& pos) const;
+  int find_node(const Vector& pos) const;
+
+  /** Follows the path from @c pos in @c direction to the next node */
+  bool trace(const Vector& pos, Direction direction, Edge& edge) const;
+
+private:
+  const WorldMapSector* m_sector;
+  std::vector<Node> m_nodes;
+  std::unordered_map<uint64_t, int> m_node_index;
+
+private:
+  NavigationGraph(const NavigationGraph&) = delete;
+  NavigationGraph& operator=(const NavigationGraph&) = delete;
+};
+
+} // namespace worldmap
@@ -48,6 +48,7 @@ Tux::Tux(WorldMap* worldmap) :
   m_direction(Direction::NONE),
   m_initial_tile_pos(),
   m_tile_pos(),
+  m_travel_path(),
   m_offset(0),
   m_moving(false),
   m_ghost_mode(false)
@@ -178,6 +179,18 @@ Tux::stop()
   m_direction = Direction::NONE;
   m_input_direction = Direction::NONE;
   m_moving = false;
+  m_travel_path.clear();
+}
+
+void
+Tux::travel(std::vector<Direction> path)
+{
+  if (path.empty())
+    return;
+
+  // The first step is taken by try_start_walking().
+  m_input_direction = path.front();
+  m_travel_path.assign(path.begin() + 1, path.end());
 }
 
 void
@@ -266,12 +279,14 @@ Tux::try_continue_walking(float dt_sec)
   // check if we are at a Teleporter
   auto teleporter = worldmap_sector->at_object<Teleporter>(m_tile_pos);
 
-  // stop if we reached a level, a WORLDMAP_STOP tile, a teleporter or a special tile without a passive_message
-  if ((worldmap_sector->at_object<LevelTile>()) ||
-      (worldmap_sector->tile_data_at(m_tile_pos) & Tile::WORLDMAP_STOP) ||
-      (special_tile && !special_tile->is_passive_message() && special_tile->get_script().empty()) ||
-      (teleporter) ||
-      m_ghost_mode)
+  // stop if we reached a level, a WORLDMAP_STOP tile, a teleporter or a special tile without a passive_message,
+  // unless travelling past them
+  if (m_travel_path.empty() &&
+      ((worldmap_sector->at_object<LevelTile>()) ||
+       (worldmap_sector->tile_data_at(m_tile_pos) & Tile::WORLDMAP_STOP) ||
+       (special_tile && !special_tile->is_passive_message() && special_tile->get_script().empty()) ||
+       (teleporter) ||
+       m_ghost_mode))
   {
     if (special_tile && !special_tile->get_map_message().empty() && !special_tile->is_passive_message()) {
       m_worldmap->set_passive_message({}, 0.0f);
@@ -282,7 +297,12 @@ Tux::try_continue_walking(float dt_sec)
 
   // if user wants to change direction, try changing, else guess the direction in which to walk next
   const int tile_data = worldmap_sector->tile_data_at(m_tile_pos);
-  if ((m_direction != m_input_direction) && can_walk(tile_data, m_input_direction)) {
+  if (!m_travel_path.empty()) {
+    m_direction = m_travel_path.front();
+    m_travel_path.pop_front();
+    m_input_direction = m_direction;
+    m_back_direction = reverse_dir(m_direction);
+  } else if ((m_direction != m_input_direction) && can_walk(tile_data, m_input_direction)) {
     m_direction = m_input_direction;
     m_back_direction = reverse_dir(m_direction);
   } else {
@@ -343,6 +363,11 @@ Tux::update_input_direction()
     m_input_direction = Direction::WEST;
   else if (m_controller.hold(Control::RIGHT))
     m_input_direction = Direction::EAST;
+  else
+    return;
+
+  // Steering by hand ends travelling.
+  m_travel_path.clear();
 }
 
 void
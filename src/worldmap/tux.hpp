@@ -19,6 +19,9 @@
 
 #include "supertux/game_object.hpp"
 
+#include <deque>
+#include <vector>
+
 #include "sprite/sprite_ptr.hpp"
 #include "supertux/player_status.hpp"
 
@@ -54,6 +57,10 @@ public:
   inline void set_initial_pos(const Vector& pos) { m_initial_tile_pos = pos / 32.f; }
   inline void set_tile_pos(const Vector& pos) { m_tile_pos = pos; }
 
+  /** Makes Tux walk the given steps without stopping in between, see
+      NavigationGraph::find_path(). Steering by hand ends it. */
+  void travel(std::vector<Direction> path);
+
   void process_special_tile(SpecialTile* special_tile);
 
 private:
@@ -78,6 +85,9 @@ private:
   Direction m_direction;
   Vector m_initial_tile_pos;
   Vector m_tile_pos;
+
+  /** Remaining steps when travelling, see travel() */
+  std::deque<Direction> m_travel_path;
   /** Length by which tux is away from its current tile, length is in
       input_direction direction */
   float m_offset;
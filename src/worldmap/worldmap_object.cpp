@@ -119,8 +119,16 @@ WorldMapObject::after_editor_set()
 void
 WorldMapObject::update_pos()
 {
-  m_tile_x = static_cast<int>(m_col.m_bbox.get_left()) / 32;
-  m_tile_y = static_cast<int>(m_col.m_bbox.get_top()) / 32;
+  const int tile_x = static_cast<int>(m_col.m_bbox.get_left()) / 32;
+  const int tile_y = static_cast<int>(m_col.m_bbox.get_top()) / 32;
+  if (tile_x == m_tile_x && tile_y == m_tile_y)
+    return;
+
+  m_tile_x = tile_x;
+  m_tile_y = tile_y;
+
+  if (auto* sector = dynamic_cast<WorldMapSector*>(get_parent()))
+    sector->invalidate_tile_index();
 }
 
 void
@@ -49,6 +49,7 @@
 #include "worldmap/special_tile.hpp"
 #include "worldmap/teleporter.hpp"
 #include "worldmap/worldmap.hpp"
+#include "worldmap/worldmap_object.hpp"
 
 namespace worldmap {
 
@@ -69,7 +70,15 @@ WorldMapSector::WorldMapSector(WorldMap& parent) :
   m_tux(&add<Tux>(&parent)),
   m_spawnpoints(),
   m_initial_fade_tilemap(),
-  m_fade_direction()
+  m_fade_direction(),
+  m_tile_index(),
+  m_tile_index_dirty(true),
+  m_tile_data(),
+  m_tile_data_width(0),
+  m_tile_data_height(0),
+  m_tile_data_sources(),
+  m_navigation(),
+  m_navigation_dirty(true)
 {
   BIND_WORLDMAP_SECTOR(*this);
 
@@ -428,11 +437,25 @@ WorldMapSector::available_directions_at(const Vector& p) const
 
 int
 WorldMapSector::tile_data_at(const Vector& p) const
+{
+  update_tile_data();
+
+  const int x = static_cast<int>(p.x);
+  const int y = static_cast<int>(p.y);
+  if (x >= 0 && x < m_tile_data_width && y >= 0 && y < m_tile_data_height)
+    return m_tile_data[y * m_tile_data_width + x];
+
+  // The tilemaps repeat their border tiles outside of them.
+  return compute_tile_data(x, y);
+}
+
+int
+WorldMapSector::compute_tile_data(int x, int y) const
 {
   int dirs = 0;
 
   for (const auto& tilemap : get_solid_tilemaps()) {
-    const Tile& tile = tilemap->get_tile(static_cast<int>(p.x), static_cast<int>(p.y));
+    const Tile& tile = tilemap->get_tile(x, y);
     int dirdata = tile.get_data();
     dirs |= dirdata;
   }
@@ -440,6 +463,51 @@ WorldMapSector::tile_data_at(const Vector& p) const
   return dirs;
 }
 
+void
+WorldMapSector::update_tile_data() const
+{
+  const auto& tilemaps = get_solid_tilemaps();
+
+  bool current = m_tile_data_sources.size() == tilemaps.size();
+  for (size_t i = 0; current && i < tilemaps.size(); ++i)
+  {
+    current = m_tile_data_sources[i].first == tilemaps[i] &&
+              m_tile_data_sources[i].second == tilemaps[i]->get_revision();
+  }
+  if (current)
+    return;
+
+  m_tile_data_sources.clear();
+  for (const auto* tilemap : tilemaps)
+    m_tile_data_sources.emplace_back(tilemap, tilemap->get_revision());
+
+  m_tile_data_width = static_cast<int>(get_tiles_width());
+  m_tile_data_height = static_cast<int>(get_tiles_height());
+  m_tile_data.resize(static_cast<size_t>(m_tile_data_width) * static_cast<size_t>(m_tile_data_height));
+  for (int y = 0; y < m_tile_data_height; ++y)
+  {
+    for (int x = 0; x < m_tile_data_width; ++x)
+    {
+      m_tile_data[y * m_tile_data_width + x] = compute_tile_data(x, y);
+    }
+  }
+
+  m_navigation_dirty = true;
+}
+
+const NavigationGraph&
+WorldMapSector::get_navigation_graph() const
+{
+  update_tile_data();
+
+  if (m_navigation_dirty)
+  {
+    m_navigation.build(*this);
+    m_navigation_dirty = false;
+  }
+  return m_navigation;
+}
+
 bool
 WorldMapSector::is_valid_path_at(const Vector& p) const
 {
@@ -618,6 +686,45 @@ WorldMapSector::move_to_spawnpoint(const std::string& spawnpoint, bool pan)
   }
 }
 
+bool
+WorldMapSector::travel_to_level(const std::string& filename)
+{
+  const LevelTile* target = nullptr;
+  for (const auto& level : get_objects_by_type<LevelTile>())
+  {
+    if (level.get_level_filename() == filename)
+    {
+      target = &level;
+      break;
+    }
+  }
+  if (!target)
+  {
+    log_warning << "Level '" << filename << "' not found on the worldmap." << std::endl;
+    return false;
+  }
+
+  const Vector tux_pos = m_tux->get_tile_pos();
+  if (m_tux->is_moving() || tux_pos == target->get_tile_pos())
+    return false;
+
+  auto path = get_navigation_graph().find_path(tux_pos, target->get_tile_pos(),
+    [this](const Vector& pos) {
+      const LevelTile* level = at_object<LevelTile>(pos);
+      return (level && !level->is_solved() && !level->is_perfect()) || at_object<Teleporter>(pos);
+    });
+  if (path.empty())
+    return false;
+
+  // Tux can only leave an unsolved level the way he came.
+  const LevelTile* level = at_object<LevelTile>(tux_pos);
+  if (level && !level->is_solved() && !level->is_perfect() && path.front() != m_tux->m_back_direction)
+    return false;
+
+  m_tux->travel(std::move(path));
+  return true;
+}
+
 void
 WorldMapSector::set_initial_fade_tilemap(const std::string& tilemap_name, int direction)
 {
@@ -638,6 +745,47 @@ WorldMapSector::get_tux_pos() const
   return m_tux->get_pos();
 }
 
+bool
+WorldMapSector::before_object_add(GameObject& object)
+{
+  if (dynamic_cast<WorldMapObject*>(&object))
+    invalidate_tile_index();
+
+  return Base::Sector::before_object_add(object);
+}
+
+void
+WorldMapSector::before_object_remove(GameObject& object)
+{
+  if (dynamic_cast<WorldMapObject*>(&object))
+    invalidate_tile_index();
+
+  Base::Sector::before_object_remove(object);
+}
+
+const std::vector<WorldMapObject*>&
+WorldMapSector::get_objects_at(const Vector& pos) const
+{
+  const auto key = [](int x, int y) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+  };
+
+  if (m_tile_index_dirty)
+  {
+    m_tile_index.clear();
+    for (auto& obj : get_objects_by_type<WorldMapObject>())
+    {
+      const Vector tile_pos = obj.get_tile_pos();
+      m_tile_index[key(static_cast<int>(tile_pos.x), static_cast<int>(tile_pos.y))].push_back(&obj);
+    }
+    m_tile_index_dirty = false;
+  }
+
+  static const std::vector<WorldMapObject*> s_empty;
+  auto it = m_tile_index.find(key(static_cast<int>(pos.x), static_cast<int>(pos.y)));
+  return it == m_tile_index.end() ? s_empty : it->second;
+}
+
 float
 WorldMapSector::get_tux_x() const
 {
@@ -673,6 +821,7 @@ WorldMapSector::register_class(ssq::VM& vm)
   cls.addFunc("set_sector", &WorldMapSector::set_sector);
   cls.addFunc("spawn", &WorldMapSector::spawn);
   cls.addFunc<void, WorldMapSector, const std::string&>("move_to_spawnpoint", &WorldMapSector::move_to_spawnpoint);
+  cls.addFunc("travel_to_level", &WorldMapSector::travel_to_level);
   cls.addFunc("get_filename", &WorldMapSector::get_filename);
   cls.addFunc("set_title_level", &WorldMapSector::set_title_level);
 }
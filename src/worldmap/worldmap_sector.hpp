@@ -20,6 +20,9 @@
 
 #include "supertux/sector_base.hpp"
 
+#include <unordered_map>
+
+#include "worldmap/navigation_graph.hpp"
 #include "worldmap/tux.hpp"
 
 namespace worldmap {
@@ -27,6 +30,7 @@ namespace worldmap {
 class Camera;
 class SpawnPoint;
 class WorldMap;
+class WorldMapObject;
 
 /** Represents one of (potentially) multiple, separate parts of a WorldMap.
     WorldMap variant of Sector, utilizing only its base features. */
@@ -97,13 +101,21 @@ public:
   template<class T>
   T* at_object(const Vector& pos) const
   {
-    for (auto& obj : get_objects_by_type<T>())
-      if (obj.get_tile_pos() == pos)
-        return &obj;
+    for (auto* obj : get_objects_at(pos))
+      if (auto* typed = dynamic_cast<T*>(obj))
+        return typed;
 
     return nullptr;
   }
 
+  /** Marks the tile position index as outdated, to be rebuilt on the next lookup.
+      Called whenever a WorldMapObject changes its tile position. */
+  inline void invalidate_tile_index() { m_tile_index_dirty = true; m_navigation_dirty = true; }
+
+  /** Returns the graph of the paths, rebuilt if the paths or the
+      objects on them changed since */
+  const NavigationGraph& get_navigation_graph() const;
+
   /** Check if it is possible to walk from \a pos into \a direction,
       if possible, write the new position to \a new_pos */
   bool path_ok(const Direction& direction, const Vector& old_pos, Vector* new_pos) const;
@@ -145,6 +157,14 @@ public:
    */
   void move_to_spawnpoint(const std::string& spawnpoint);
   void move_to_spawnpoint(const std::string& spawnpoint, bool pan);
+  /**
+   * @scripting
+   * @description Makes Tux walk to the level ""filename"" along the shortest path,
+                  which must not pass any unsolved level or teleporter.
+                  Returns false if there is no such path.
+   * @param string $filename
+   */
+  bool travel_to_level(const std::string& filename);
 
   /**
    * @scripting
@@ -172,6 +192,18 @@ protected:
 
   void draw_status(DrawingContext& context);
 
+  bool before_object_add(GameObject& object) override;
+  void before_object_remove(GameObject& object) override;
+
+private:
+  /** Returns all WorldMapObjects on the tile at @c pos. */
+  const std::vector<WorldMapObject*>& get_objects_at(const Vector& pos) const;
+
+  /** Rebuilds m_tile_data, if any of the solid tilemaps was changed,
+      added or removed since */
+  void update_tile_data() const;
+  int compute_tile_data(int x, int y) const;
+
 private:
   WorldMap& m_parent;
 
@@ -182,6 +214,20 @@ private:
   std::string m_initial_fade_tilemap;
   int m_fade_direction;
 
+  /** WorldMapObjects, keyed by their tile position. */
+  mutable std::unordered_map<uint64_t, std::vector<WorldMapObject*>> m_tile_index;
+  mutable bool m_tile_index_dirty;
+
+  /** Union of the tile data of the solid tilemaps, see tile_data_at(),
+      and the tilemaps and their revisions it was computed from */
+  mutable std::vector<int> m_tile_data;
+  mutable int m_tile_data_width;
+  mutable int m_tile_data_height;
+  mutable std::vector<std::pair<const TileMap*, uint32_t>> m_tile_data_sources;
+
+  mutable NavigationGraph m_navigation;
+  mutable bool m_navigation_dirty;
+
 private:
   WorldMapSector(const WorldMapSector&) = delete;
   WorldMapSector& operator=(const WorldMapSector&) = delete;
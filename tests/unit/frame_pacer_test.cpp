@@ -0,0 +1,72 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <chrono>
+
+#include "st_assert.hpp"
+#include "supertux/frame_pacer.hpp"
+
+using Clock = FramePacer::Clock;
+
+int main(void)
+{
+  FramePacer pacer;
+
+  // Sleeping never returns early. How late it is depends on the load of
+  // the machine, so that isn't checked.
+  bool never_early = true;
+  for (int i = 0; i < 20; ++i)
+  {
+    const auto deadline = Clock::now() + std::chrono::microseconds(2500);
+    pacer.sleep_until(deadline);
+    never_early = never_early && Clock::now() >= deadline;
+  }
+  ST_ASSERT("sleep_until never returns early", never_early);
+
+  // The deadlines are computed from the time passed in, not the clock.
+  const Clock::time_point start(std::chrono::seconds(100));
+  pacer.set_target_fps(120.0f, start);
+  const Clock::duration frame = pacer.next_frame(start) - start;
+  ST_ASSERT("the frame duration matches the target",
+            frame > std::chrono::microseconds(8330) && frame < std::chrono::microseconds(8340));
+
+  // Frames that finish in time are paced without drifting.
+  Clock::time_point deadline = start + frame;
+  bool evenly_spaced = true;
+  for (int i = 2; i <= 120; ++i)
+  {
+    const Clock::time_point next = pacer.next_frame(deadline - std::chrono::milliseconds(2));
+    evenly_spaced = evenly_spaced && next - deadline == frame;
+    deadline = next;
+  }
+  ST_ASSERT("frames are evenly spaced", evenly_spaced);
+  ST_ASSERT("120 frames take a second",
+            deadline - start > std::chrono::microseconds(999900) &&
+            deadline - start < std::chrono::microseconds(1000100));
+
+  // A slow frame pushes the following ones back instead of rushing them.
+  const Clock::time_point late = deadline + std::chrono::milliseconds(50);
+  ST_ASSERT("a late frame is due right away", pacer.next_frame(late) == late);
+  ST_ASSERT("the frame after a late one is paced again", pacer.next_frame(late) == late + frame);
+
+  // Without a cap, frames aren't delayed.
+  pacer.set_target_fps(0.0f, start);
+  ST_ASSERT("uncapped frames are due right away", pacer.next_frame(start) == start);
+
+  return 0;
+}
+
+/* EOF */
@@ -0,0 +1,142 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <physfs.h>
+
+#include "physfs/ifile_data.hpp"
+#include "physfs/ifile_stream.hpp"
+#include "st_assert.hpp"
+
+// The real implementation drags in the whole file system layer.
+namespace physfsutil {
+const char* get_last_error()
+{
+  return PHYSFS_getErrorByCode(PHYSFS_getLastErrorCode());
+}
+} // namespace physfsutil
+
+using Clock = std::chrono::steady_clock;
+
+static void collect_files(const std::string& dir, std::vector<std::string>& files)
+{
+  char** list = PHYSFS_enumerateFiles(dir.c_str());
+  for (char** i = list; *i != nullptr; ++i)
+  {
+    const std::string path = dir.empty() ? *i : dir + "/" + *i;
+    PHYSFS_Stat stat;
+    if (!PHYSFS_stat(path.c_str(), &stat))
+      continue;
+    if (stat.filetype == PHYSFS_FILETYPE_DIRECTORY)
+      collect_files(path, files);
+    else if (stat.filetype == PHYSFS_FILETYPE_REGULAR)
+      files.push_back(path);
+  }
+  PHYSFS_freeList(list);
+}
+
+static std::string read_stream(const std::string& filename, size_t buffer_size)
+{
+  IFileStream in(filename, buffer_size);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static double to_ms(Clock::duration duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/** Checks that IFileData reads the same bytes as IFileStream. Given a
+    directory, e.g. "IFileDataTest ../data", it also compares all read
+    paths on every file below it and reports how long each of them takes,
+    which is too slow to be done on every test run. */
+int main(int argc, char** argv)
+{
+  PHYSFS_init(argv[0]);
+  ST_ASSERT("the test data is mounted", PHYSFS_mount(TEST_DATA_DIR, "mounted", 1) != 0);
+
+  // Mount points have to be stripped before the file can be mapped.
+  {
+    IFileData data("mounted/test.dat");
+    ST_ASSERT("IFileData matches IFileStream", read_stream("mounted/test.dat", 0) == data.view());
+    ST_ASSERT("IFileData matches IFileStream with a small buffer", read_stream("mounted/test.dat", 16) == data.view());
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+    ST_ASSERT("files below a mount point are mapped", data.is_mapped());
+#endif
+  }
+
+  if (argc < 2)
+  {
+    PHYSFS_deinit();
+    return 0;
+  }
+
+  const std::string datadir = argv[1];
+  if (!PHYSFS_mount(datadir.c_str(), nullptr, 1))
+  {
+    std::cout << "Couldn't mount '" << datadir << "'" << std::endl;
+    PHYSFS_deinit();
+    return 1;
+  }
+
+  std::vector<std::string> files;
+  collect_files("", files);
+
+  size_t total_bytes = 0;
+  bool all_equal = true;
+  Clock::duration small_buffer_time{}, default_buffer_time{}, data_time{};
+  for (const auto& filename : files)
+  {
+    auto start = Clock::now();
+    const std::string small_buffer = read_stream(filename, 1024);
+    auto end = Clock::now();
+    small_buffer_time += end - start;
+
+    start = Clock::now();
+    const std::string default_buffer = read_stream(filename, 0);
+    end = Clock::now();
+    default_buffer_time += end - start;
+
+    start = Clock::now();
+    IFileData data(filename);
+    end = Clock::now();
+    data_time += end - start;
+
+    if (small_buffer != default_buffer || small_buffer != data.view())
+    {
+      std::cerr << "Read paths disagree on '" << filename << "'" << std::endl;
+      all_equal = false;
+    }
+    total_bytes += data.size();
+  }
+
+  ST_ASSERT("all read paths return the same bytes", all_equal);
+
+  std::cout << "Read " << files.size() << " files, " << total_bytes / 1024 << " KiB\n"
+            << "  IFileStream, 1 KiB buffer:  " << to_ms(small_buffer_time) << " ms\n"
+            << "  IFileStream, 64 KiB buffer: " << to_ms(default_buffer_time) << " ms\n"
+            << "  IFileData:                  " << to_ms(data_time) << " ms" << std::endl;
+
+  PHYSFS_deinit();
+  return 0;
+}
+
+/* EOF */
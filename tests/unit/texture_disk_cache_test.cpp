@@ -0,0 +1,95 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <filesystem>
+#include <string.h>
+#include <string>
+
+#include <physfs.h>
+
+#include "st_assert.hpp"
+#include "video/texture_disk_cache.hpp"
+
+static void write_file(const std::string& filename, const std::string& content)
+{
+  PHYSFS_mkdir(filename.substr(0, filename.rfind('/')).c_str());
+  PHYSFS_File* file = PHYSFS_openWrite(filename.c_str());
+  PHYSFS_writeBytes(file, content.data(), content.size());
+  PHYSFS_close(file);
+}
+
+static bool same_pixels(const SDL_Surface& lhs, const SDL_Surface& rhs)
+{
+  if (lhs.w != rhs.w || lhs.h != rhs.h || lhs.format->format != rhs.format->format)
+    return false;
+
+  for (int y = 0; y < lhs.h; ++y)
+  {
+    if (memcmp(static_cast<const char*>(lhs.pixels) + y * lhs.pitch,
+               static_cast<const char*>(rhs.pixels) + y * rhs.pitch, lhs.w * 4) != 0)
+      return false;
+  }
+  return true;
+}
+
+int main(int, char** argv)
+{
+  std::filesystem::remove_all(TEST_WRITE_DIR);
+  std::filesystem::create_directories(TEST_WRITE_DIR);
+
+  PHYSFS_init(argv[0]);
+  PHYSFS_setWriteDir(TEST_WRITE_DIR);
+  PHYSFS_mount(TEST_WRITE_DIR, nullptr, 1);
+
+  const std::string source = "images/tile.png";
+  write_file(source, "not really a PNG");
+
+  SDLSurfacePtr image(SDL_CreateRGBSurfaceWithFormat(0, 64, 32, 32, SDL_PIXELFORMAT_RGBA32));
+  for (int i = 0; i < image->h * image->pitch; ++i)
+    static_cast<uint8_t*>(image->pixels)[i] = static_cast<uint8_t>(i * 7 / 5);
+
+  ST_ASSERT("there is no entry before storing one", !TextureDiskCache::load(source));
+  ST_ASSERT("the image is stored", TextureDiskCache::store(source, *image));
+  {
+    SDLSurfacePtr cached = TextureDiskCache::load(source);
+    ST_ASSERT("the stored image is loaded", cached && same_pixels(*cached, *image));
+  }
+
+  // A subregion shares the pitch of the whole image.
+  SDLSurfacePtr region(SDL_CreateRGBSurfaceWithFormatFrom(static_cast<uint8_t*>(image->pixels) + 4 * image->pitch + 8 * 4,
+                                                          16, 8, 32, image->pitch, SDL_PIXELFORMAT_RGBA32));
+  ST_ASSERT("a subregion is stored", TextureDiskCache::store(source, *region));
+  {
+    SDLSurfacePtr cached = TextureDiskCache::load(source);
+    ST_ASSERT("the stored subregion is loaded", cached && same_pixels(*cached, *region));
+  }
+
+  SDLSurfacePtr rgb(SDL_CreateRGBSurfaceWithFormat(0, 4, 4, 24, SDL_PIXELFORMAT_RGB24));
+  ST_ASSERT("only RGBA images are stored", !TextureDiskCache::store(source, *rgb));
+
+  write_file(TextureDiskCache::get_path(source), "truncated");
+  ST_ASSERT("a broken entry is ignored", !TextureDiskCache::load(source));
+
+  TextureDiskCache::store(source, *image);
+  write_file(source, "a modified, larger image");
+  ST_ASSERT("the entry of a modified image is ignored", !TextureDiskCache::load(source));
+
+  PHYSFS_deinit();
+  std::filesystem::remove_all(TEST_WRITE_DIR);
+  return 0;
+}
+
+/* EOF */
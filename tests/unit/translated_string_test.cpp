@@ -0,0 +1,104 @@
+//  SuperTux
+//  Copyright (C) 2026 SuperTux Devs
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include "st_assert.hpp"
+#include "util/gettext.hpp"
+
+// Every allocation of the test is counted.
+static size_t s_allocations = 0;
+
+void* operator new(size_t size)
+{
+  ++s_allocations;
+  if (void* ptr = std::malloc(size ? size : 1))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+static size_t s_length = 0;
+
+/** Stands in for drawing the text */
+static void draw(const std::string& text)
+{
+  s_length += text.size();
+}
+
+static std::string decorate(const std::string& header)
+{
+  return "- " + header + " -";
+}
+
+/** Counts the allocations of drawing the statistics header of the level
+    intro and the worldmap for the given number of frames */
+template<typename Draw>
+static size_t count_allocations(int frames, Draw draw_frame)
+{
+  const size_t before = s_allocations;
+  for (int i = 0; i < frames; ++i)
+    draw_frame();
+  return s_allocations - before;
+}
+
+int main(void)
+{
+  const int frames = 1000;
+
+  // What the draw functions did before, translating and decorating the
+  // header on every frame.
+  const size_t allocations_before = count_allocations(frames, [] {
+    draw("- " + _("Best Level Statistics") + " -");
+  });
+
+  static const TranslatedString s_header(N_("Best Level Statistics"), &decorate);
+  draw(s_header);
+  const size_t allocations_after = count_allocations(frames, [] {
+    draw(s_header);
+  });
+
+  std::cout << "Allocations per frame: " << static_cast<double>(allocations_before) / frames
+            << " before, " << static_cast<double>(allocations_after) / frames << " after" << std::endl;
+
+  ST_ASSERT("the header is decorated", s_header.get() == "- Best Level Statistics -");
+  ST_ASSERT("building the header every frame allocates", allocations_before >= static_cast<size_t>(frames));
+  ST_ASSERT("a translated header doesn't allocate per frame", allocations_after == 0);
+
+  // A new language translates and decorates the header once more.
+  invalidate_translations();
+  const size_t allocations_changed = count_allocations(frames, [] {
+    draw(s_header);
+  });
+  ST_ASSERT("a language change rebuilds the header once", allocations_changed > 0 && allocations_changed < 10);
+  ST_ASSERT("the rebuilt header is decorated", s_header.get() == "- Best Level Statistics -");
+
+  return 0;
+}
+
+/* EOF */